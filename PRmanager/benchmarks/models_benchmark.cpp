@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json.hpp>
+
+#include "models/pull_request.hpp"
+#include "models/response.hpp"
+#include "models/stats.hpp"
+#include "models/team.hpp"
+#include "models/user.hpp"
+
+namespace {
+
+using prmanager::models::PullRequestShort;
+using prmanager::models::ReviewsResponse;
+using prmanager::models::Team;
+using prmanager::models::TeamMember;
+
+constexpr auto kToValue =
+    userver::formats::serialize::To<userver::formats::json::Value>{};
+
+Team MakeTeam(std::int64_t members) {
+  Team team;
+  team.team_name = "team";
+  team.members.reserve(members);
+  for (std::int64_t i = 0; i < members; ++i) {
+    team.members.push_back(TeamMember{"u" + std::to_string(i),
+                                      "user " + std::to_string(i), i % 5 != 0});
+  }
+  return team;
+}
+
+ReviewsResponse MakeReviews(std::int64_t prs) {
+  ReviewsResponse response;
+  response.user_id = "u0";
+  response.pull_requests.reserve(prs);
+  for (std::int64_t i = 0; i < prs; ++i) {
+    response.pull_requests.push_back(
+        PullRequestShort{"pr-" + std::to_string(i),
+                         "Pull request number " + std::to_string(i),
+                         "u" + std::to_string(i % 100), "OPEN"});
+  }
+  return response;
+}
+
+std::string MakeTeamAddBatchBody(std::int64_t teams) {
+  userver::formats::json::ValueBuilder teams_builder(
+      userver::formats::common::Type::kArray);
+  for (std::int64_t i = 0; i < teams; ++i) {
+    auto team = MakeTeam(5);
+    team.team_name = "team" + std::to_string(i);
+    teams_builder.PushBack(prmanager::models::Serialize(team, kToValue));
+  }
+  userver::formats::json::ValueBuilder body;
+  body["teams"] = teams_builder.ExtractValue();
+  return userver::formats::json::ToString(body.ExtractValue());
+}
+
+}  // namespace
+
+void TeamParse(benchmark::State& state) {
+  const auto body = userver::formats::json::ToString(
+      prmanager::models::Serialize(MakeTeam(state.range(0)), kToValue));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        userver::formats::json::FromString(body).As<Team>());
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(TeamParse)->Arg(1)->Arg(100)->Arg(10000);
+
+void TeamSerializeValue(benchmark::State& state) {
+  const auto team = MakeTeam(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::json::ToString(
+        prmanager::models::Serialize(team, kToValue)));
+  }
+}
+BENCHMARK(TeamSerializeValue)->Arg(1)->Arg(100)->Arg(10000);
+
+void TeamWriteToStream(benchmark::State& state) {
+  const auto team = MakeTeam(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(prmanager::models::ToJsonString(team));
+  }
+}
+BENCHMARK(TeamWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
+
+void TeamAddBatchParse(benchmark::State& state) {
+  const auto body = MakeTeamAddBatchBody(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::json::FromString(body)
+                                 .As<prmanager::models::TeamAddBatchRequest>());
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(TeamAddBatchParse)->Arg(1)->Arg(100)->Arg(10000);
+
+void MassDeactivateParse(benchmark::State& state) {
+  userver::formats::json::ValueBuilder user_ids(
+      userver::formats::common::Type::kArray);
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    user_ids.PushBack("u" + std::to_string(i));
+  }
+  userver::formats::json::ValueBuilder builder;
+  builder["user_ids"] = user_ids.ExtractValue();
+  const auto body = userver::formats::json::ToString(builder.ExtractValue());
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        userver::formats::json::FromString(body)
+            .As<prmanager::models::MassDeactivateRequest>());
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(MassDeactivateParse)->Arg(1)->Arg(100)->Arg(10000);
+
+void PullRequestSerializeValue(benchmark::State& state) {
+  const auto reviews = MakeReviews(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    userver::formats::json::ValueBuilder response;
+    response["user_id"] = reviews.user_id;
+    response["pull_requests"] = reviews.pull_requests;
+    benchmark::DoNotOptimize(
+        userver::formats::json::ToString(response.ExtractValue()));
+  }
+}
+BENCHMARK(PullRequestSerializeValue)->Arg(1)->Arg(100)->Arg(10000);
+
+void PullRequestWriteToStream(benchmark::State& state) {
+  const auto reviews = MakeReviews(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(prmanager::models::ToJsonString(reviews));
+  }
+}
+BENCHMARK(PullRequestWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
+
+void PullRequestWithReviewersWriteToStream(benchmark::State& state) {
+  prmanager::models::PullRequestResponse response;
+  response.pr.pull_request_id = "pr-1";
+  response.pr.pull_request_name = "Pull request";
+  response.pr.author_id = "u0";
+  response.pr.status = "OPEN";
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    response.pr.assigned_reviewers.push_back("u" + std::to_string(i + 1));
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(prmanager::models::ToJsonString(response));
+  }
+}
+BENCHMARK(PullRequestWithReviewersWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
+
+void UserWriteToStream(benchmark::State& state) {
+  std::vector<prmanager::models::UserResponse> users;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    users.push_back({{"u" + std::to_string(i), "user " + std::to_string(i),
+                      "team", true}});
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& user : users) {
+      benchmark::DoNotOptimize(prmanager::models::ToJsonString(user));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(UserWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
+
+void StatsWriteToStream(benchmark::State& state) {
+  prmanager::models::StatsResponse stats{1, 2, 3};
+  stats.mean_time_to_merge_seconds = 42.5;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    stats.teams_load.push_back({"team" + std::to_string(i), i});
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(prmanager::models::ToJsonString(stats));
+  }
+}
+BENCHMARK(StatsWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
+
+void ReviewerStatsWriteToStream(benchmark::State& state) {
+  prmanager::models::ReviewerStatsResponse stats;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    stats.reviewers.push_back({"u" + std::to_string(i), i % 7, i});
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(prmanager::models::ToJsonString(stats));
+  }
+}
+BENCHMARK(ReviewerStatsWriteToStream)->Arg(1)->Arg(100)->Arg(10000);
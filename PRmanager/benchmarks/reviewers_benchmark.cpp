@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "models/review_load_index.hpp"
+#include "models/team_roster.hpp"
+#include "utils/random.hpp"
+
+namespace {
+
+using prmanager::models::TeamRoster;
+
+TeamRoster MakeRoster(std::int64_t members) {
+  TeamRoster roster;
+  const auto now = std::chrono::system_clock::now();
+  for (std::int64_t i = 0; i < members; ++i) {
+    roster.Upsert({"u" + std::to_string(i), "team", i % 5 != 0, now});
+  }
+  return roster;
+}
+
+}  // namespace
+
+// Candidate list for a new PR: active teammates without the author.
+void ReviewerCandidates(benchmark::State& state) {
+  const auto roster = MakeRoster(state.range(0));
+  const std::vector<std::string> excluded{"u1"};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(roster.GetActiveMembers("team", excluded));
+  }
+}
+BENCHMARK(ReviewerCandidates)->Arg(1)->Arg(100)->Arg(10000);
+
+// Full create path: filtering plus picking two reviewers.
+void ReviewerSample(benchmark::State& state) {
+  const auto roster = MakeRoster(state.range(0));
+  const std::vector<std::string> excluded{"u1"};
+  std::mt19937 rng{std::random_device{}()};
+  for ([[maybe_unused]] auto _ : state) {
+    const auto candidates = roster.GetActiveMembers("team", excluded);
+    std::vector<std::string> reviewers;
+    std::sample(candidates.begin(), candidates.end(),
+                std::back_inserter(reviewers), 2, rng);
+    benchmark::DoNotOptimize(reviewers);
+  }
+}
+BENCHMARK(ReviewerSample)->Arg(1)->Arg(100)->Arg(10000);
+
+// Mass deactivation excludes the current reviewers and the already picked
+// replacements of every PR, so the excluded list grows with the batch.
+void ReviewerSampleManyExcluded(benchmark::State& state) {
+  const auto roster = MakeRoster(10000);
+  std::vector<std::string> excluded;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    excluded.push_back("u" + std::to_string(i * 3));
+  }
+  std::mt19937 rng{std::random_device{}()};
+  for ([[maybe_unused]] auto _ : state) {
+    const auto candidates = roster.GetActiveMembers("team", excluded);
+    std::string reviewer;
+    std::sample(candidates.begin(), candidates.end(), &reviewer, 1, rng);
+    benchmark::DoNotOptimize(reviewer);
+  }
+}
+BENCHMARK(ReviewerSampleManyExcluded)->Arg(1)->Arg(100)->Arg(1000);
+
+// Least loaded pick used by create: one index lookup plus a short walk.
+void ReviewerPickLeastLoaded(benchmark::State& state) {
+  prmanager::models::ReviewLoadIndex index;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    const auto user_id = "u" + std::to_string(i);
+    index.SetMember(user_id, "team", i % 5 != 0);
+    index.SetLoad(user_id, i % 7);
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    auto reviewers = index.PickLeastLoaded(
+        "team", 2, [](const std::string& user_id) { return user_id == "u1"; });
+    for (const auto& user_id : reviewers) {
+      index.AddLoad(user_id, 1);
+    }
+    benchmark::DoNotOptimize(reviewers);
+  }
+}
+BENCHMARK(ReviewerPickLeastLoaded)->Arg(1)->Arg(100)->Arg(10000);
+
+// Per-request generator construction, as the handlers used to do.
+void ReviewerRngConstruction(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    std::mt19937 rng{std::random_device{}()};
+    benchmark::DoNotOptimize(rng());
+  }
+}
+BENCHMARK(ReviewerRngConstruction);
+
+// Thread-local generator from utils/random.hpp, for comparison with the above.
+void ReviewerRngThreadLocal(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        prmanager::utils::WithRng([](auto& rng) { return rng(); }));
+  }
+}
+BENCHMARK(ReviewerRngThreadLocal);
+
+// Reassign fallback: one reviewer sampled with the thread-local generator.
+void ReviewerSampleThreadLocal(benchmark::State& state) {
+  const auto roster = MakeRoster(state.range(0));
+  const std::vector<std::string> excluded{"u1"};
+  for ([[maybe_unused]] auto _ : state) {
+    const auto candidates = roster.GetActiveMembers("team", excluded);
+    std::string reviewer;
+    prmanager::utils::WithRng([&](auto& rng) {
+      std::sample(candidates.begin(), candidates.end(), &reviewer, 1, rng);
+    });
+    benchmark::DoNotOptimize(reviewer);
+  }
+}
+BENCHMARK(ReviewerSampleThreadLocal)->Arg(1)->Arg(100)->Arg(10000);
+
+void RosterUpsert(benchmark::State& state) {
+  const auto now = std::chrono::system_clock::now();
+  for ([[maybe_unused]] auto _ : state) {
+    TeamRoster roster;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      roster.Upsert({"u" + std::to_string(i), "team", true, now});
+    }
+    benchmark::DoNotOptimize(roster.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RosterUpsert)->Arg(1)->Arg(100)->Arg(10000);
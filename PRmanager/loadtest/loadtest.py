@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""HTTP load generator for PRmanager.
+
+Seeds teams, users and pull requests through the public API, then replays a
+weighted mix of create/merge/reassign/getReview/massDeactivate requests for a
+fixed duration and prints throughput and latency percentiles per endpoint.
+
+Every run uses its own id prefix, so it can be repeated against the same
+database (e.g. the docker-compose Postgres) without cleanup.
+
+    python3 loadtest/loadtest.py --scenario loadtest/scenarios/default.json
+"""
+
+import argparse
+import asyncio
+import json
+import math
+import random
+import sys
+import time
+import uuid
+
+import aiohttp
+
+OPERATIONS = ("create", "merge", "reassign", "get_review", "mass_deactivate")
+
+
+class EndpointStats:
+    def __init__(self):
+        self.latencies = []
+        self.statuses = {}
+        self.failures = 0
+
+    def record(self, latency, status):
+        self.latencies.append(latency)
+        self.statuses[status] = self.statuses.get(status, 0) + 1
+
+    def percentile(self, p):
+        if not self.latencies:
+            return 0.0
+        rank = max(1, math.ceil(p * len(self.latencies)))
+        return self.latencies[rank - 1]
+
+
+class World:
+    """Client-side view of the data, used to build valid requests."""
+
+    def __init__(self, prefix, rng):
+        self.prefix = prefix
+        self.rng = rng
+        self.teams = []
+        self.users = []
+        self.active = set()
+        self.open_prs = {}
+        self.pr_seq = 0
+
+    def next_pr_id(self):
+        self.pr_seq += 1
+        return f"{self.prefix}-pr-{self.pr_seq}"
+
+    def pick_author(self):
+        team = self.rng.choice(self.teams)
+        return self.rng.choice(team)
+
+
+class Runner:
+    def __init__(self, session, base_url, scenario, world):
+        self.session = session
+        self.base_url = base_url.rstrip("/")
+        self.scenario = scenario
+        self.world = world
+        self.stats = {}
+
+    async def call(self, name, method, path, **kwargs):
+        stats = self.stats.setdefault(name, EndpointStats())
+        start = time.perf_counter()
+        try:
+            async with self.session.request(
+                method, self.base_url + path, **kwargs
+            ) as response:
+                body = await response.read()
+                stats.record(time.perf_counter() - start, response.status)
+                if not body:
+                    return response.status, None
+                return response.status, json.loads(body)
+        except (aiohttp.ClientError, asyncio.TimeoutError):
+            stats.failures += 1
+            return None, None
+
+    async def create(self):
+        pr_id = self.world.next_pr_id()
+        status, body = await self.call(
+            "create", "POST", "/pullRequest/create",
+            json={
+                "pull_request_id": pr_id,
+                "pull_request_name": f"Load test {pr_id}",
+                "author_id": self.world.pick_author(),
+            },
+        )
+        if status == 201:
+            self.world.open_prs[pr_id] = body["pr"]["assigned_reviewers"]
+
+    async def merge(self):
+        if not self.world.open_prs:
+            return await self.create()
+        pr_id = self.world.rng.choice(list(self.world.open_prs))
+        self.world.open_prs.pop(pr_id)
+        await self.call(
+            "merge", "POST", "/pullRequest/merge",
+            json={"pull_request_id": pr_id},
+        )
+
+    async def reassign(self):
+        reviewed = [pr for pr, reviewers in self.world.open_prs.items()
+                    if reviewers]
+        if not reviewed:
+            return await self.create()
+        pr_id = self.world.rng.choice(reviewed)
+        reviewers = self.world.open_prs[pr_id]
+        old_user_id = self.world.rng.choice(reviewers)
+        status, body = await self.call(
+            "reassign", "POST", "/pullRequest/reassign",
+            json={"pull_request_id": pr_id, "old_user_id": old_user_id},
+        )
+        if status == 200 and pr_id in self.world.open_prs:
+            self.world.open_prs[pr_id] = body["pr"]["assigned_reviewers"]
+
+    async def get_review(self):
+        user_id = self.world.rng.choice(self.world.users)
+        await self.call(
+            "get_review", "GET", "/users/getReview",
+            params={"user_id": user_id},
+        )
+
+    async def mass_deactivate(self):
+        size = self.scenario.get("mass_deactivate_size", 3)
+        team = self.world.rng.choice(self.world.teams)
+        active = [user for user in team if user in self.world.active]
+        # Keep enough reviewers in the team for the rest of the mix.
+        if len(active) <= size + 2:
+            return await self.get_review()
+        user_ids = self.world.rng.sample(active, size)
+        self.world.active.difference_update(user_ids)
+        await self.call(
+            "mass_deactivate", "POST", "/users/massDeactivate",
+            json={"user_ids": user_ids},
+        )
+        # Bring the users back so the candidate pools stay stable.
+        for user_id in user_ids:
+            await self.call(
+                "set_is_active", "POST", "/users/setIsActive",
+                json={"user_id": user_id, "is_active": True},
+            )
+        self.world.active.update(user_ids)
+
+
+async def seed(runner, scenario):
+    world = runner.world
+    config = scenario["seed"]
+    teams = []
+    for t in range(config["teams"]):
+        members = [
+            {
+                "user_id": f"{world.prefix}-u-{t}-{u}",
+                "username": f"user {t}-{u}",
+                "is_active": True,
+            }
+            for u in range(config["users_per_team"])
+        ]
+        teams.append({"team_name": f"{world.prefix}-team-{t}",
+                      "members": members})
+        world.teams.append([member["user_id"] for member in members])
+        world.users.extend(world.teams[-1])
+        world.active.update(world.teams[-1])
+
+    for start in range(0, len(teams), 100):
+        status, _ = await runner.call(
+            "seed_teams", "POST", "/team/addBatch",
+            json={"teams": teams[start:start + 100]},
+        )
+        if status != 200:
+            sys.exit(f"seeding teams failed with status {status}")
+
+    remaining = config["prs"]
+
+    async def seed_worker():
+        nonlocal remaining
+        while remaining > 0:
+            remaining -= 1
+            await runner.create()
+
+    await asyncio.gather(
+        *(seed_worker() for _ in range(scenario["concurrency"])))
+    # Only the replay phase goes into the report.
+    runner.stats.clear()
+
+
+async def replay(runner, scenario):
+    mix = scenario["mix"]
+    operations = [op for op in OPERATIONS if mix.get(op)]
+    weights = [mix[op] for op in operations]
+    deadline = time.perf_counter() + scenario["duration_s"]
+
+    async def worker():
+        while time.perf_counter() < deadline:
+            op = runner.world.rng.choices(operations, weights)[0]
+            await getattr(runner, op)()
+
+    start = time.perf_counter()
+    await asyncio.gather(
+        *(worker() for _ in range(scenario["concurrency"])))
+    return time.perf_counter() - start
+
+
+def build_report(stats, elapsed):
+    report = {}
+    for name, endpoint in sorted(stats.items()):
+        endpoint.latencies.sort()
+        report[name] = {
+            "requests": len(endpoint.latencies),
+            "rps": len(endpoint.latencies) / elapsed if elapsed else 0.0,
+            "p50_ms": endpoint.percentile(0.50) * 1000,
+            "p99_ms": endpoint.percentile(0.99) * 1000,
+            "p999_ms": endpoint.percentile(0.999) * 1000,
+            "max_ms": (endpoint.latencies[-1] * 1000
+                       if endpoint.latencies else 0.0),
+            "statuses": {str(k): v for k, v in
+                         sorted(endpoint.statuses.items())},
+            "failures": endpoint.failures,
+        }
+    return report
+
+
+def print_report(report, elapsed):
+    print(f"\nreplay: {elapsed:.1f}s")
+    print(f"{'endpoint':<16}{'requests':>10}{'rps':>10}{'p50 ms':>10}"
+          f"{'p99 ms':>10}{'p999 ms':>10}{'max ms':>10}  statuses")
+    total = 0
+    for name, row in report.items():
+        total += row["requests"]
+        statuses = " ".join(f"{k}:{v}" for k, v in row["statuses"].items())
+        if row["failures"]:
+            statuses += f" failed:{row['failures']}"
+        print(f"{name:<16}{row['requests']:>10}{row['rps']:>10.1f}"
+              f"{row['p50_ms']:>10.2f}{row['p99_ms']:>10.2f}"
+              f"{row['p999_ms']:>10.2f}{row['max_ms']:>10.2f}  {statuses}")
+    print(f"total: {total} requests, {total / elapsed:.1f} rps")
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--base-url", default="http://localhost:8080")
+    parser.add_argument("--scenario", required=True,
+                        help="path to a scenario JSON file")
+    parser.add_argument("--duration", type=float,
+                        help="override duration_s from the scenario")
+    parser.add_argument("--concurrency", type=int,
+                        help="override concurrency from the scenario")
+    parser.add_argument("--seed", type=int, default=None,
+                        help="random seed for a reproducible request mix")
+    parser.add_argument("--json-output",
+                        help="also write the report to this file")
+    args = parser.parse_args()
+
+    with open(args.scenario) as scenario_file:
+        scenario = json.load(scenario_file)
+    if args.duration is not None:
+        scenario["duration_s"] = args.duration
+    if args.concurrency is not None:
+        scenario["concurrency"] = args.concurrency
+
+    prefix = f"lt{uuid.uuid4().hex[:8]}"
+    world = World(prefix, random.Random(args.seed))
+    connector = aiohttp.TCPConnector(limit=scenario["concurrency"])
+    timeout = aiohttp.ClientTimeout(total=30)
+    async with aiohttp.ClientSession(connector=connector,
+                                     timeout=timeout) as session:
+        runner = Runner(session, args.base_url, scenario, world)
+
+        seed_start = time.perf_counter()
+        await seed(runner, scenario)
+        print(f"seeded {len(world.teams)} teams, "
+              f"{len(world.users)} users, {len(world.open_prs)} open "
+              f"PRs in {time.perf_counter() - seed_start:.1f}s "
+              f"(prefix {prefix})")
+
+        elapsed = await replay(runner, scenario)
+
+    report = build_report(runner.stats, elapsed)
+    print_report(report, elapsed)
+    if args.json_output:
+        with open(args.json_output, "w") as output:
+            json.dump({"prefix": prefix, "elapsed_s": elapsed,
+                       "scenario": scenario, "endpoints": report},
+                      output, indent=2)
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -14,8 +14,17 @@ CREATE TABLE IF NOT EXISTS prmanager.users (
     updated_at TIMESTAMPTZ DEFAULT NOW()
 );
 
-CREATE INDEX IF NOT EXISTS idx_users_team_name ON prmanager.users(team_name);
-CREATE INDEX IF NOT EXISTS idx_users_is_active ON prmanager.users(is_active);
+-- The text key columns are gone after 007_surrogate_keys.sql.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'users'
+               AND column_name = 'team_name') THEN
+        CREATE INDEX IF NOT EXISTS idx_users_team_name
+            ON prmanager.users(team_name);
+    END IF;
+END
+$$;
 
 CREATE TABLE IF NOT EXISTS prmanager.pull_requests (
     id TEXT PRIMARY KEY,
@@ -27,7 +36,6 @@ CREATE TABLE IF NOT EXISTS prmanager.pull_requests (
 );
 
 CREATE INDEX IF NOT EXISTS idx_pr_author_id ON prmanager.pull_requests(author_id);
-CREATE INDEX IF NOT EXISTS idx_pr_status ON prmanager.pull_requests(status);
 
 CREATE TABLE IF NOT EXISTS prmanager.reviewers (
     pull_request_id TEXT NOT NULL REFERENCES prmanager.pull_requests(id) ON DELETE CASCADE,
@@ -36,4 +44,13 @@ CREATE TABLE IF NOT EXISTS prmanager.reviewers (
     PRIMARY KEY (pull_request_id, reviewer_id)
 );
 
-CREATE INDEX IF NOT EXISTS idx_reviewers_reviewer_id ON prmanager.reviewers(reviewer_id);
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+               AND column_name = 'reviewer_id') THEN
+        CREATE INDEX IF NOT EXISTS idx_reviewers_reviewer_id
+            ON prmanager.reviewers(reviewer_id);
+    END IF;
+END
+$$;
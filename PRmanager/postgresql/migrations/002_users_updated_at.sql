@@ -0,0 +1,26 @@
+UPDATE prmanager.users SET updated_at = NOW() WHERE updated_at IS NULL;
+
+ALTER TABLE prmanager.users
+    ALTER COLUMN updated_at SET NOT NULL,
+    ALTER COLUMN updated_at SET DEFAULT clock_timestamp();
+
+CREATE INDEX IF NOT EXISTS idx_users_updated_at ON prmanager.users(updated_at);
+
+-- 003_pull_requests_updated_at.sql replaces the body; a re-run must not
+-- put this one back.
+DO $$
+BEGIN
+    IF to_regprocedure('prmanager.touch_updated_at()') IS NULL THEN
+        CREATE FUNCTION prmanager.touch_updated_at() RETURNS TRIGGER AS $fn$
+        BEGIN
+            NEW.updated_at = clock_timestamp();
+            RETURN NEW;
+        END;
+        $fn$ LANGUAGE plpgsql;
+    END IF;
+END
+$$;
+
+CREATE OR REPLACE TRIGGER trg_users_touch_updated_at
+    BEFORE INSERT OR UPDATE ON prmanager.users
+    FOR EACH ROW EXECUTE FUNCTION prmanager.touch_updated_at();
@@ -0,0 +1,28 @@
+ALTER TABLE prmanager.pull_requests
+    ADD COLUMN IF NOT EXISTS updated_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp();
+
+CREATE INDEX IF NOT EXISTS idx_pr_updated_at ON prmanager.pull_requests(updated_at);
+
+-- No-op updates (e.g. a repeated merge) must not look like changes.
+CREATE OR REPLACE FUNCTION prmanager.touch_updated_at() RETURNS TRIGGER AS $$
+BEGIN
+    IF TG_OP = 'UPDATE' AND NEW IS NOT DISTINCT FROM OLD THEN
+        RETURN NEW;
+    END IF;
+    NEW.updated_at = clock_timestamp();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE TRIGGER trg_pr_touch_updated_at
+    BEFORE INSERT OR UPDATE ON prmanager.pull_requests
+    FOR EACH ROW EXECUTE FUNCTION prmanager.touch_updated_at();
+
+-- Reviewer changes used to bump the PR row as well. The stats aggregates
+-- follow the event log now (StatsAggregatesCache): the bump rewrote the PR
+-- and all of its indexes on every create and reviewer swap.
+DROP TRIGGER IF EXISTS trg_reviewers_insert_touch_pr ON prmanager.reviewers;
+DROP TRIGGER IF EXISTS trg_reviewers_delete_touch_pr ON prmanager.reviewers;
+DROP TRIGGER IF EXISTS trg_reviewers_update_touch_pr ON prmanager.reviewers;
+DROP FUNCTION IF EXISTS prmanager.touch_pr_of_new_reviewers();
+DROP FUNCTION IF EXISTS prmanager.touch_pr_of_old_reviewers();
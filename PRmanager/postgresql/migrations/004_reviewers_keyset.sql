@@ -0,0 +1,26 @@
+-- Only until the column is NOT NULL: the update would scan every partition
+-- of reviewers (009_archive_partitions.sql) on each run.
+DO $$
+BEGIN
+    IF (SELECT is_nullable FROM information_schema.columns
+        WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+        AND column_name = 'assigned_at') = 'YES' THEN
+        UPDATE prmanager.reviewers SET assigned_at = NOW()
+        WHERE assigned_at IS NULL;
+        ALTER TABLE prmanager.reviewers ALTER COLUMN assigned_at SET NOT NULL;
+    END IF;
+END
+$$;
+
+-- Keyset pagination of /users/getReview. 007_surrogate_keys.sql builds it
+-- on the integer columns under the same name.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+               AND column_name = 'reviewer_id') THEN
+        CREATE INDEX IF NOT EXISTS idx_reviewers_reviewer_assigned
+            ON prmanager.reviewers(reviewer_id, assigned_at, pull_request_id);
+    END IF;
+END
+$$;
@@ -0,0 +1,106 @@
+-- Append-only change feed, written by triggers in the transaction of the
+-- change. seq order is the order of inserts, not of commits; readers skip
+-- a gap only once every transaction that could hold it has ended (see
+-- src/models/event_log.hpp).
+CREATE TABLE IF NOT EXISTS prmanager.events (
+    seq BIGSERIAL PRIMARY KEY,
+    type TEXT NOT NULL,
+    pull_request_id TEXT,
+    user_id TEXT,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp()
+);
+
+-- The time of the change rather than of the start of its transaction.
+ALTER TABLE prmanager.events
+    ALTER COLUMN created_at SET DEFAULT clock_timestamp();
+
+CREATE OR REPLACE FUNCTION prmanager.log_pr_created() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'pr_created', id, author_id FROM new_prs ORDER BY id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE FUNCTION prmanager.log_pr_merged() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'pr_merged', n.id, n.author_id
+    FROM new_prs n JOIN old_prs o ON o.id = n.id
+    WHERE o.status = 'OPEN' AND n.status = 'MERGED'
+    ORDER BY n.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE FUNCTION prmanager.log_users_activity() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, user_id)
+    SELECT CASE WHEN n.is_active THEN 'user_activated'
+                ELSE 'user_deactivated' END, n.id
+    FROM new_users n JOIN old_users o ON o.id = n.id
+    WHERE o.is_active <> n.is_active
+    ORDER BY n.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE TRIGGER trg_pr_insert_log
+    AFTER INSERT ON prmanager.pull_requests
+    REFERENCING NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_created();
+
+CREATE OR REPLACE TRIGGER trg_pr_update_log
+    AFTER UPDATE ON prmanager.pull_requests
+    REFERENCING OLD TABLE AS old_prs NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_merged();
+
+CREATE OR REPLACE TRIGGER trg_users_update_log
+    AFTER UPDATE ON prmanager.users
+    REFERENCING OLD TABLE AS old_users NEW TABLE AS new_users
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_users_activity();
+
+-- Reviewers on the text columns only: 007_surrogate_keys.sql and
+-- 009_archive_partitions.sql define these functions and triggers for the
+-- tables they rebuild.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+               AND column_name = 'reviewer_id') THEN
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_assigned()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_assigned', pull_request_id, reviewer_id
+            FROM new_reviewers
+            ORDER BY pull_request_id, reviewer_id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_unassigned()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_unassigned', pull_request_id, reviewer_id
+            FROM old_reviewers
+            ORDER BY pull_request_id, reviewer_id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_insert_log
+            AFTER INSERT ON prmanager.reviewers
+            REFERENCING NEW TABLE AS new_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_assigned();
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_delete_log
+            AFTER DELETE ON prmanager.reviewers
+            REFERENCING OLD TABLE AS old_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_unassigned();
+    END IF;
+END
+$$;
@@ -0,0 +1,37 @@
+-- Reviewer replacements update the row in place instead of deleting and
+-- inserting it, so the feed gets the same pair of events from the update.
+-- Text columns only, like the triggers of 005_events.sql.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+               AND column_name = 'reviewer_id') THEN
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_swapped()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_unassigned', pull_request_id, reviewer_id FROM (
+                SELECT pull_request_id, reviewer_id FROM old_reviewers
+                EXCEPT
+                SELECT pull_request_id, reviewer_id FROM new_reviewers
+            ) removed
+            ORDER BY pull_request_id, reviewer_id;
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_assigned', pull_request_id, reviewer_id FROM (
+                SELECT pull_request_id, reviewer_id FROM new_reviewers
+                EXCEPT
+                SELECT pull_request_id, reviewer_id FROM old_reviewers
+            ) added
+            ORDER BY pull_request_id, reviewer_id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_update_log
+            AFTER UPDATE ON prmanager.reviewers
+            REFERENCING OLD TABLE AS old_reviewers NEW TABLE AS new_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_swapped();
+    END IF;
+END
+$$;
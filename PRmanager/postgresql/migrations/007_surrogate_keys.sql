@@ -0,0 +1,170 @@
+-- Integer keys for joins. Text ids (names for teams) stay the external
+-- identifiers and are resolved once per statement; reviewers, the largest
+-- table, holds integers only. Every conversion checks whether it has
+-- already run, like the rest of the migrations.
+
+DO $$
+BEGIN
+    IF to_regtype('prmanager.pr_status') IS NULL THEN
+        CREATE TYPE prmanager.pr_status AS ENUM ('OPEN', 'MERGED');
+    END IF;
+END
+$$;
+
+-- Existing rows are numbered when the column is added.
+ALTER TABLE prmanager.teams
+    ADD COLUMN IF NOT EXISTS id INTEGER GENERATED ALWAYS AS IDENTITY;
+CREATE UNIQUE INDEX IF NOT EXISTS idx_teams_id ON prmanager.teams(id);
+
+ALTER TABLE prmanager.users
+    ADD COLUMN IF NOT EXISTS uid BIGINT GENERATED ALWAYS AS IDENTITY;
+CREATE UNIQUE INDEX IF NOT EXISTS idx_users_uid ON prmanager.users(uid);
+
+ALTER TABLE prmanager.pull_requests
+    ADD COLUMN IF NOT EXISTS uid BIGINT GENERATED ALWAYS AS IDENTITY;
+CREATE UNIQUE INDEX IF NOT EXISTS idx_pr_uid ON prmanager.pull_requests(uid);
+
+-- users.team_name -> users.team_id. Triggers are off so the conversion does
+-- not show up as a change of every user.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'users'
+               AND column_name = 'team_name') THEN
+        ALTER TABLE prmanager.users ADD COLUMN team_id INTEGER
+            REFERENCES prmanager.teams(id) ON DELETE CASCADE;
+        ALTER TABLE prmanager.users DISABLE TRIGGER USER;
+        UPDATE prmanager.users u SET team_id = t.id
+        FROM prmanager.teams t WHERE t.name = u.team_name;
+        ALTER TABLE prmanager.users ENABLE TRIGGER USER;
+        ALTER TABLE prmanager.users ALTER COLUMN team_id SET NOT NULL;
+        ALTER TABLE prmanager.users DROP COLUMN team_name;
+    END IF;
+END
+$$;
+
+CREATE INDEX IF NOT EXISTS idx_users_team_id ON prmanager.users(team_id);
+
+DO $$
+BEGIN
+    IF (SELECT data_type FROM information_schema.columns
+        WHERE table_schema = 'prmanager' AND table_name = 'pull_requests'
+        AND column_name = 'status') = 'text' THEN
+        ALTER TABLE prmanager.pull_requests
+            DROP CONSTRAINT IF EXISTS pull_requests_status_check,
+            ALTER COLUMN status DROP DEFAULT,
+            ALTER COLUMN status TYPE prmanager.pr_status
+                USING status::prmanager.pr_status,
+            ALTER COLUMN status SET DEFAULT 'OPEN';
+    END IF;
+END
+$$;
+
+-- reviewers is rebuilt rather than altered: both key columns and both
+-- indexes change. Writers wait on the lock instead of being lost.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.columns
+               WHERE table_schema = 'prmanager' AND table_name = 'reviewers'
+               AND column_name = 'reviewer_id') THEN
+        LOCK TABLE prmanager.reviewers IN EXCLUSIVE MODE;
+        CREATE TABLE prmanager.reviewers_by_uid (
+            pull_request_uid BIGINT NOT NULL
+                REFERENCES prmanager.pull_requests(uid) ON DELETE CASCADE,
+            reviewer_uid BIGINT NOT NULL
+                REFERENCES prmanager.users(uid) ON DELETE CASCADE,
+            assigned_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+            PRIMARY KEY (pull_request_uid, reviewer_uid)
+        );
+        INSERT INTO prmanager.reviewers_by_uid
+        SELECT pr.uid, u.uid, r.assigned_at
+        FROM prmanager.reviewers r
+        JOIN prmanager.pull_requests pr ON pr.id = r.pull_request_id
+        JOIN prmanager.users u ON u.id = r.reviewer_id;
+        DROP TABLE prmanager.reviewers;
+        ALTER TABLE prmanager.reviewers_by_uid RENAME TO reviewers;
+        ALTER INDEX prmanager.reviewers_by_uid_pkey RENAME TO reviewers_pkey;
+    END IF;
+END
+$$;
+
+CREATE INDEX IF NOT EXISTS idx_reviewers_reviewer_assigned
+    ON prmanager.reviewers(reviewer_uid, assigned_at, pull_request_uid);
+
+-- Trigger functions of the earlier migrations, on the integer columns;
+-- dropping the old table dropped its triggers. Until reviewers is
+-- partitioned: 009_archive_partitions.sql has its own versions.
+DO $$
+BEGIN
+    IF (SELECT relkind FROM pg_class
+        WHERE oid = 'prmanager.reviewers'::regclass) = 'r' THEN
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_assigned()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_assigned', pr.id, u.id FROM new_reviewers n
+            JOIN prmanager.pull_requests pr ON pr.uid = n.pull_request_uid
+            JOIN prmanager.users u ON u.uid = n.reviewer_uid
+            ORDER BY pr.id, u.id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_unassigned()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_unassigned', pr.id, u.id FROM old_reviewers o
+            JOIN prmanager.pull_requests pr ON pr.uid = o.pull_request_uid
+            JOIN prmanager.users u ON u.uid = o.reviewer_uid
+            ORDER BY pr.id, u.id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE FUNCTION prmanager.log_reviewers_swapped()
+        RETURNS TRIGGER AS $fn$
+        BEGIN
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_unassigned', pr.id, u.id FROM (
+                SELECT pull_request_uid, reviewer_uid FROM old_reviewers
+                EXCEPT
+                SELECT pull_request_uid, reviewer_uid FROM new_reviewers
+            ) removed
+            JOIN prmanager.pull_requests pr
+                ON pr.uid = removed.pull_request_uid
+            JOIN prmanager.users u ON u.uid = removed.reviewer_uid
+            ORDER BY pr.id, u.id;
+            INSERT INTO prmanager.events (type, pull_request_id, user_id)
+            SELECT 'reviewer_assigned', pr.id, u.id FROM (
+                SELECT pull_request_uid, reviewer_uid FROM new_reviewers
+                EXCEPT
+                SELECT pull_request_uid, reviewer_uid FROM old_reviewers
+            ) added
+            JOIN prmanager.pull_requests pr ON pr.uid = added.pull_request_uid
+            JOIN prmanager.users u ON u.uid = added.reviewer_uid
+            ORDER BY pr.id, u.id;
+            RETURN NULL;
+        END;
+        $fn$ LANGUAGE plpgsql;
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_insert_log
+            AFTER INSERT ON prmanager.reviewers
+            REFERENCING NEW TABLE AS new_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_assigned();
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_delete_log
+            AFTER DELETE ON prmanager.reviewers
+            REFERENCING OLD TABLE AS old_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_unassigned();
+
+        CREATE OR REPLACE TRIGGER trg_reviewers_update_log
+            AFTER UPDATE ON prmanager.reviewers
+            REFERENCING OLD TABLE AS old_reviewers NEW TABLE AS new_reviewers
+            FOR EACH STATEMENT
+            EXECUTE FUNCTION prmanager.log_reviewers_swapped();
+    END IF;
+END
+$$;
@@ -0,0 +1,36 @@
+-- Indexes matched to the statements in src/db/queries.hpp. Plans of the
+-- request path statements are checked by tests/test_query_plans.py.
+
+-- Nothing filters on these flags alone; the partial indexes below cover
+-- the shapes that do. 001 no longer creates them.
+DROP INDEX IF EXISTS prmanager.idx_users_is_active;
+DROP INDEX IF EXISTS prmanager.idx_pr_status;
+
+-- Reviewer candidates: active members of a team, read from the index.
+CREATE INDEX IF NOT EXISTS idx_users_team_active
+    ON prmanager.users(team_id) INCLUDE (id, uid) WHERE is_active;
+
+-- Open PRs only: review loads and the open reviews of mass deactivation.
+CREATE INDEX IF NOT EXISTS idx_pr_open
+    ON prmanager.pull_requests(uid) INCLUDE (author_id) WHERE status = 'OPEN';
+
+-- getReview reads the PR side of the join from idx_pr_uid. The foreign key
+-- of reviewers depends on the index, so it is dropped with the old index
+-- and added again against the covering one.
+DO $$
+BEGIN
+    IF EXISTS (SELECT 1 FROM pg_index
+               WHERE indexrelid = 'prmanager.idx_pr_uid'::regclass
+               AND indnatts = indnkeyatts) THEN
+        CREATE UNIQUE INDEX idx_pr_uid_covering
+            ON prmanager.pull_requests(uid)
+            INCLUDE (id, name, author_id, status);
+        DROP INDEX prmanager.idx_pr_uid CASCADE;
+        ALTER INDEX prmanager.idx_pr_uid_covering RENAME TO idx_pr_uid;
+        ALTER TABLE prmanager.reviewers
+            ADD CONSTRAINT reviewers_pull_request_uid_fkey
+            FOREIGN KEY (pull_request_uid)
+            REFERENCES prmanager.pull_requests(uid) ON DELETE CASCADE;
+    END IF;
+END
+$$;
@@ -0,0 +1,266 @@
+-- pull_requests and reviewers are partitioned by archived_month. Rows start
+-- in the 'infinity' partitions (pull_requests_hot, reviewers_hot), which
+-- hold the open PRs and the recently merged ones. The archiver
+-- (src/components/pull_request_archiver.hpp) moves older merged PRs and
+-- their reviewers into one partition per merge month, see
+-- archive_merged_month below. Open PRs are never archived, so statements
+-- about open PRs filter on archived_month = 'infinity' and read only the
+-- hot partitions.
+--
+-- Status is not part of the key on purpose: merging would move the row to
+-- another partition, and a statement waiting on a moved row fails instead
+-- of seeing the new version (a second merge, reassign).
+--
+-- A partitioned table cannot keep ids unique across partitions, so PR ids
+-- and their integer keys are registered in pull_request_keys.
+
+CREATE TABLE IF NOT EXISTS prmanager.pull_request_keys (
+    id TEXT PRIMARY KEY,
+    uid BIGINT GENERATED ALWAYS AS IDENTITY
+);
+CREATE UNIQUE INDEX IF NOT EXISTS idx_pr_keys_uid
+    ON prmanager.pull_request_keys(uid);
+
+-- Both tables are rebuilt as partitioned ones; all existing rows go to the
+-- hot partitions and are archived by the job later. Writers wait on the
+-- lock instead of being lost.
+DO $$
+BEGIN
+    IF (SELECT relkind FROM pg_class
+        WHERE oid = 'prmanager.pull_requests'::regclass) = 'r' THEN
+        LOCK TABLE prmanager.pull_requests, prmanager.reviewers
+            IN EXCLUSIVE MODE;
+
+        INSERT INTO prmanager.pull_request_keys (id, uid)
+        OVERRIDING SYSTEM VALUE
+        SELECT id, uid FROM prmanager.pull_requests;
+        PERFORM setval(
+            pg_get_serial_sequence('prmanager.pull_request_keys', 'uid'),
+            COALESCE(MAX(uid), 0) + 1, false)
+        FROM prmanager.pull_request_keys;
+
+        CREATE TABLE prmanager.pull_requests_partitioned (
+            id TEXT NOT NULL,
+            uid BIGINT NOT NULL,
+            name TEXT NOT NULL,
+            author_id TEXT NOT NULL,
+            status prmanager.pr_status NOT NULL DEFAULT 'OPEN',
+            created_at TIMESTAMPTZ DEFAULT NOW(),
+            merged_at TIMESTAMPTZ,
+            updated_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp(),
+            archived_month DATE NOT NULL DEFAULT 'infinity'
+        ) PARTITION BY LIST (archived_month);
+        CREATE TABLE prmanager.pull_requests_hot
+            PARTITION OF prmanager.pull_requests_partitioned
+            FOR VALUES IN ('infinity');
+        INSERT INTO prmanager.pull_requests_partitioned
+            (id, uid, name, author_id, status, created_at, merged_at,
+             updated_at)
+        SELECT id, uid, name, author_id, status, created_at, merged_at,
+               updated_at
+        FROM prmanager.pull_requests;
+
+        CREATE TABLE prmanager.reviewers_partitioned (
+            pull_request_uid BIGINT NOT NULL,
+            reviewer_uid BIGINT NOT NULL,
+            assigned_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+            archived_month DATE NOT NULL DEFAULT 'infinity'
+        ) PARTITION BY LIST (archived_month);
+        CREATE TABLE prmanager.reviewers_hot
+            PARTITION OF prmanager.reviewers_partitioned
+            FOR VALUES IN ('infinity');
+        INSERT INTO prmanager.reviewers_partitioned
+            (pull_request_uid, reviewer_uid, assigned_at)
+        SELECT pull_request_uid, reviewer_uid, assigned_at
+        FROM prmanager.reviewers;
+
+        DROP TABLE prmanager.reviewers;
+        DROP TABLE prmanager.pull_requests;
+        ALTER TABLE prmanager.pull_requests_partitioned RENAME TO pull_requests;
+        ALTER TABLE prmanager.reviewers_partitioned RENAME TO reviewers;
+
+        ALTER TABLE prmanager.pull_requests
+            ADD PRIMARY KEY (id, archived_month),
+            ADD CONSTRAINT pull_requests_open_not_archived
+                CHECK (archived_month = 'infinity' OR status = 'MERGED'),
+            ADD FOREIGN KEY (uid)
+                REFERENCES prmanager.pull_request_keys(uid),
+            ADD FOREIGN KEY (author_id)
+                REFERENCES prmanager.users(id) ON DELETE CASCADE;
+        -- Names of 001..008, so their re-runs find the indexes.
+        CREATE UNIQUE INDEX idx_pr_uid ON prmanager.pull_requests
+            (uid, archived_month) INCLUDE (id, name, author_id, status);
+        CREATE INDEX idx_pr_open ON prmanager.pull_requests(uid)
+            INCLUDE (author_id) WHERE status = 'OPEN';
+        CREATE INDEX idx_pr_updated_at
+            ON prmanager.pull_requests(updated_at);
+        CREATE INDEX idx_pr_author_id ON prmanager.pull_requests(author_id);
+
+        ALTER TABLE prmanager.reviewers
+            ADD PRIMARY KEY (pull_request_uid, reviewer_uid, archived_month),
+            ADD FOREIGN KEY (pull_request_uid, archived_month)
+                REFERENCES prmanager.pull_requests(uid, archived_month)
+                ON DELETE CASCADE,
+            ADD FOREIGN KEY (reviewer_uid)
+                REFERENCES prmanager.users(uid) ON DELETE CASCADE;
+        CREATE INDEX idx_reviewers_reviewer_assigned ON prmanager.reviewers
+            (reviewer_uid, assigned_at, pull_request_uid);
+    END IF;
+END
+$$;
+
+-- Merged PRs still in the hot partition, for the archiver. Only there:
+-- archive partitions hold nothing else.
+CREATE INDEX IF NOT EXISTS idx_pr_hot_merged_at
+    ON prmanager.pull_requests_hot(merged_at) WHERE status = 'MERGED';
+
+-- Moves the PRs merged in `merged_month` (UTC) and their reviewers out of
+-- the hot partitions into new partitions of that month; returns the number
+-- of PRs moved. Rows are copied into plain tables that are attached
+-- afterwards, so no triggers fire: the event feed and updated_at stay as
+-- they are. A month is archived once, later calls for it return 0.
+CREATE OR REPLACE FUNCTION prmanager.archive_merged_month(merged_month DATE)
+RETURNS BIGINT AS $$
+DECLARE
+    month_start TIMESTAMPTZ := merged_month::timestamp AT TIME ZONE 'UTC';
+    month_end TIMESTAMPTZ :=
+        (merged_month + INTERVAL '1 month') AT TIME ZONE 'UTC';
+    bound TEXT := to_char(merged_month, 'YYYY-MM-DD');
+    pr_table TEXT := 'pull_requests_' || to_char(merged_month, 'YYYY_MM');
+    reviewers_table TEXT := 'reviewers_' || to_char(merged_month, 'YYYY_MM');
+    moved BIGINT;
+BEGIN
+    -- Every instance runs the job; the others wait and find the month done.
+    PERFORM pg_advisory_xact_lock(hashtext('prmanager.archive_merged_month'));
+    IF to_regclass('prmanager.' || pr_table) IS NOT NULL THEN
+        RETURN 0;
+    END IF;
+
+    EXECUTE format('CREATE TABLE prmanager.%I (LIKE prmanager.pull_requests '
+                   'INCLUDING DEFAULTS INCLUDING CONSTRAINTS)', pr_table);
+    EXECUTE format('CREATE TABLE prmanager.%I (LIKE prmanager.reviewers '
+                   'INCLUDING DEFAULTS INCLUDING CONSTRAINTS)',
+                   reviewers_table);
+
+    -- Reviewers first, deleting the PRs would cascade to them.
+    EXECUTE format(
+        'WITH moved AS ('
+        '  DELETE FROM prmanager.reviewers_hot r '
+        '  USING prmanager.pull_requests_hot pr '
+        '  WHERE r.pull_request_uid = pr.uid AND pr.status = ''MERGED'' '
+        '  AND pr.merged_at >= $1 AND pr.merged_at < $2 '
+        '  RETURNING r.pull_request_uid, r.reviewer_uid, r.assigned_at'
+        ') INSERT INTO prmanager.%I '
+        '(pull_request_uid, reviewer_uid, assigned_at, archived_month) '
+        'SELECT pull_request_uid, reviewer_uid, assigned_at, $3 FROM moved',
+        reviewers_table) USING month_start, month_end, merged_month;
+    EXECUTE format(
+        'WITH moved AS ('
+        '  DELETE FROM prmanager.pull_requests_hot '
+        '  WHERE status = ''MERGED'' '
+        '  AND merged_at >= $1 AND merged_at < $2 '
+        '  RETURNING id, uid, name, author_id, status, created_at, '
+        '  merged_at, updated_at'
+        ') INSERT INTO prmanager.%I '
+        '(id, uid, name, author_id, status, created_at, merged_at, '
+        'updated_at, archived_month) '
+        'SELECT id, uid, name, author_id, status, created_at, merged_at, '
+        'updated_at, $3 FROM moved',
+        pr_table) USING month_start, month_end, merged_month;
+    GET DIAGNOSTICS moved = ROW_COUNT;
+
+    -- Builds the indexes and checks the foreign keys of the new partitions.
+    EXECUTE format('ALTER TABLE prmanager.pull_requests ATTACH PARTITION '
+                   'prmanager.%I FOR VALUES IN (%L)', pr_table, bound);
+    EXECUTE format('ALTER TABLE prmanager.reviewers ATTACH PARTITION '
+                   'prmanager.%I FOR VALUES IN (%L)', reviewers_table, bound);
+    RETURN moved;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Trigger functions join reviewers to their PR on both key columns, so
+-- only the partition of the PR is read. Earlier migrations define their
+-- versions only for the tables as they had them.
+CREATE OR REPLACE FUNCTION prmanager.log_reviewers_assigned() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_assigned', pr.id, u.id FROM new_reviewers n
+    JOIN prmanager.pull_requests pr ON pr.uid = n.pull_request_uid
+        AND pr.archived_month = n.archived_month
+    JOIN prmanager.users u ON u.uid = n.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE FUNCTION prmanager.log_reviewers_unassigned() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_unassigned', pr.id, u.id FROM old_reviewers o
+    JOIN prmanager.pull_requests pr ON pr.uid = o.pull_request_uid
+        AND pr.archived_month = o.archived_month
+    JOIN prmanager.users u ON u.uid = o.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE FUNCTION prmanager.log_reviewers_swapped() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_unassigned', pr.id, u.id FROM (
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM old_reviewers
+        EXCEPT
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM new_reviewers
+    ) removed
+    JOIN prmanager.pull_requests pr ON pr.uid = removed.pull_request_uid
+        AND pr.archived_month = removed.archived_month
+    JOIN prmanager.users u ON u.uid = removed.reviewer_uid
+    ORDER BY pr.id, u.id;
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_assigned', pr.id, u.id FROM (
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM new_reviewers
+        EXCEPT
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM old_reviewers
+    ) added
+    JOIN prmanager.pull_requests pr ON pr.uid = added.pull_request_uid
+        AND pr.archived_month = added.archived_month
+    JOIN prmanager.users u ON u.uid = added.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Dropping the old tables dropped their triggers.
+CREATE OR REPLACE TRIGGER trg_pr_touch_updated_at
+    BEFORE INSERT OR UPDATE ON prmanager.pull_requests
+    FOR EACH ROW EXECUTE FUNCTION prmanager.touch_updated_at();
+
+CREATE OR REPLACE TRIGGER trg_pr_insert_log
+    AFTER INSERT ON prmanager.pull_requests
+    REFERENCING NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_created();
+
+CREATE OR REPLACE TRIGGER trg_pr_update_log
+    AFTER UPDATE ON prmanager.pull_requests
+    REFERENCING OLD TABLE AS old_prs NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_merged();
+
+CREATE OR REPLACE TRIGGER trg_reviewers_insert_log
+    AFTER INSERT ON prmanager.reviewers
+    REFERENCING NEW TABLE AS new_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_assigned();
+
+CREATE OR REPLACE TRIGGER trg_reviewers_delete_log
+    AFTER DELETE ON prmanager.reviewers
+    REFERENCING OLD TABLE AS old_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_unassigned();
+
+CREATE OR REPLACE TRIGGER trg_reviewers_update_log
+    AFTER UPDATE ON prmanager.reviewers
+    REFERENCING OLD TABLE AS old_reviewers NEW TABLE AS new_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_swapped();
@@ -1,28 +1,302 @@
 DROP SCHEMA IF EXISTS prmanager CASCADE;
 CREATE SCHEMA IF NOT EXISTS prmanager;
 
+-- Text ids (names for teams) are the external identifiers; the integer
+-- keys are internal and used for joins. Statements resolve a text id once.
 CREATE TABLE prmanager.teams (
-    name TEXT PRIMARY KEY
+    name TEXT PRIMARY KEY,
+    id INTEGER GENERATED ALWAYS AS IDENTITY
 );
 
+CREATE UNIQUE INDEX idx_teams_id ON prmanager.teams(id);
+
 CREATE TABLE prmanager.users (
     id TEXT PRIMARY KEY,
+    uid BIGINT GENERATED ALWAYS AS IDENTITY,
     username TEXT NOT NULL,
-    team_name TEXT NOT NULL REFERENCES prmanager.teams(name),
-    is_active BOOLEAN NOT NULL DEFAULT TRUE
+    team_id INTEGER NOT NULL REFERENCES prmanager.teams(id),
+    is_active BOOLEAN NOT NULL DEFAULT TRUE,
+    updated_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp()
 );
 
-CREATE TABLE prmanager.pull_requests (
+CREATE UNIQUE INDEX idx_users_uid ON prmanager.users(uid);
+CREATE INDEX idx_users_team_id ON prmanager.users(team_id);
+-- Reviewer candidates: active members of a team, read from the index.
+CREATE INDEX idx_users_team_active
+    ON prmanager.users(team_id) INCLUDE (id, uid) WHERE is_active;
+CREATE INDEX idx_users_updated_at ON prmanager.users(updated_at);
+
+CREATE FUNCTION prmanager.touch_updated_at() RETURNS TRIGGER AS $$
+BEGIN
+    IF TG_OP = 'UPDATE' AND NEW IS NOT DISTINCT FROM OLD THEN
+        RETURN NEW;
+    END IF;
+    NEW.updated_at = clock_timestamp();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER trg_users_touch_updated_at
+    BEFORE INSERT OR UPDATE ON prmanager.users
+    FOR EACH ROW EXECUTE FUNCTION prmanager.touch_updated_at();
+
+CREATE TYPE prmanager.pr_status AS ENUM ('OPEN', 'MERGED');
+
+-- Integer keys of PRs. Ids have to be unique across all partitions of
+-- pull_requests, which a partitioned table cannot enforce.
+CREATE TABLE prmanager.pull_request_keys (
     id TEXT PRIMARY KEY,
+    uid BIGINT GENERATED ALWAYS AS IDENTITY
+);
+
+CREATE UNIQUE INDEX idx_pr_keys_uid ON prmanager.pull_request_keys(uid);
+
+-- PRs and reviewers are partitioned by archived_month. 'infinity' is the
+-- hot partition with the open and the recently merged PRs; older merged
+-- ones are moved into a partition per merge month by
+-- archive_merged_month(). Statements about open PRs filter on
+-- archived_month = 'infinity' and read the hot partitions only.
+CREATE TABLE prmanager.pull_requests (
+    id TEXT NOT NULL,
+    uid BIGINT NOT NULL REFERENCES prmanager.pull_request_keys(uid),
     name TEXT NOT NULL,
     author_id TEXT NOT NULL REFERENCES prmanager.users(id),
-    status TEXT NOT NULL DEFAULT 'OPEN' CHECK (status IN ('OPEN', 'MERGED')),
+    status prmanager.pr_status NOT NULL DEFAULT 'OPEN',
     created_at TIMESTAMPTZ DEFAULT NOW(),
-    merged_at TIMESTAMPTZ
-);
+    merged_at TIMESTAMPTZ,
+    updated_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp(),
+    archived_month DATE NOT NULL DEFAULT 'infinity',
+    PRIMARY KEY (id, archived_month),
+    CONSTRAINT pull_requests_open_not_archived
+        CHECK (archived_month = 'infinity' OR status = 'MERGED')
+) PARTITION BY LIST (archived_month);
+
+CREATE TABLE prmanager.pull_requests_hot
+    PARTITION OF prmanager.pull_requests FOR VALUES IN ('infinity');
+
+-- Covers the PR side of the getReview join.
+CREATE UNIQUE INDEX idx_pr_uid ON prmanager.pull_requests
+    (uid, archived_month) INCLUDE (id, name, author_id, status);
+-- Open PRs only: review loads and the open reviews of mass deactivation.
+CREATE INDEX idx_pr_open
+    ON prmanager.pull_requests(uid) INCLUDE (author_id) WHERE status = 'OPEN';
+CREATE INDEX idx_pr_updated_at ON prmanager.pull_requests(updated_at);
+-- Merged PRs still in the hot partition, for the archiver. Only there:
+-- archive partitions hold nothing else.
+CREATE INDEX idx_pr_hot_merged_at
+    ON prmanager.pull_requests_hot(merged_at) WHERE status = 'MERGED';
 
+CREATE TRIGGER trg_pr_touch_updated_at
+    BEFORE INSERT OR UPDATE ON prmanager.pull_requests
+    FOR EACH ROW EXECUTE FUNCTION prmanager.touch_updated_at();
+
+-- Reviewers share the archived_month of their PR.
 CREATE TABLE prmanager.reviewers (
-    pull_request_id TEXT NOT NULL REFERENCES prmanager.pull_requests(id),
-    reviewer_id TEXT NOT NULL REFERENCES prmanager.users(id),
-    PRIMARY KEY (pull_request_id, reviewer_id)
+    pull_request_uid BIGINT NOT NULL,
+    reviewer_uid BIGINT NOT NULL REFERENCES prmanager.users(uid),
+    assigned_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+    archived_month DATE NOT NULL DEFAULT 'infinity',
+    PRIMARY KEY (pull_request_uid, reviewer_uid, archived_month),
+    FOREIGN KEY (pull_request_uid, archived_month)
+        REFERENCES prmanager.pull_requests(uid, archived_month)
+        ON DELETE CASCADE
+) PARTITION BY LIST (archived_month);
+
+CREATE TABLE prmanager.reviewers_hot
+    PARTITION OF prmanager.reviewers FOR VALUES IN ('infinity');
+
+CREATE INDEX idx_reviewers_reviewer_assigned
+    ON prmanager.reviewers(reviewer_uid, assigned_at, pull_request_uid);
+
+-- Append-only change feed, written by triggers in the transaction of the
+-- change. seq order is the order of inserts, not of commits; readers skip
+-- a gap only once every transaction that could hold it has ended (see
+-- src/models/event_log.hpp).
+CREATE TABLE prmanager.events (
+    seq BIGSERIAL PRIMARY KEY,
+    type TEXT NOT NULL,
+    pull_request_id TEXT,
+    user_id TEXT,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT clock_timestamp()
 );
+
+CREATE FUNCTION prmanager.log_pr_created() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'pr_created', id, author_id FROM new_prs ORDER BY id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE FUNCTION prmanager.log_pr_merged() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'pr_merged', n.id, n.author_id
+    FROM new_prs n JOIN old_prs o ON o.id = n.id
+    WHERE o.status = 'OPEN' AND n.status = 'MERGED'
+    ORDER BY n.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE FUNCTION prmanager.log_reviewers_assigned() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_assigned', pr.id, u.id FROM new_reviewers n
+    JOIN prmanager.pull_requests pr ON pr.uid = n.pull_request_uid
+        AND pr.archived_month = n.archived_month
+    JOIN prmanager.users u ON u.uid = n.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE FUNCTION prmanager.log_reviewers_unassigned() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_unassigned', pr.id, u.id FROM old_reviewers o
+    JOIN prmanager.pull_requests pr ON pr.uid = o.pull_request_uid
+        AND pr.archived_month = o.archived_month
+    JOIN prmanager.users u ON u.uid = o.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Reviewer replacements update the row in place; the feed still gets an
+-- unassigned/assigned pair.
+CREATE FUNCTION prmanager.log_reviewers_swapped() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_unassigned', pr.id, u.id FROM (
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM old_reviewers
+        EXCEPT
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM new_reviewers
+    ) removed
+    JOIN prmanager.pull_requests pr ON pr.uid = removed.pull_request_uid
+        AND pr.archived_month = removed.archived_month
+    JOIN prmanager.users u ON u.uid = removed.reviewer_uid
+    ORDER BY pr.id, u.id;
+    INSERT INTO prmanager.events (type, pull_request_id, user_id)
+    SELECT 'reviewer_assigned', pr.id, u.id FROM (
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM new_reviewers
+        EXCEPT
+        SELECT pull_request_uid, reviewer_uid, archived_month
+        FROM old_reviewers
+    ) added
+    JOIN prmanager.pull_requests pr ON pr.uid = added.pull_request_uid
+        AND pr.archived_month = added.archived_month
+    JOIN prmanager.users u ON u.uid = added.reviewer_uid
+    ORDER BY pr.id, u.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE FUNCTION prmanager.log_users_activity() RETURNS TRIGGER AS $$
+BEGIN
+    INSERT INTO prmanager.events (type, user_id)
+    SELECT CASE WHEN n.is_active THEN 'user_activated'
+                ELSE 'user_deactivated' END, n.id
+    FROM new_users n JOIN old_users o ON o.id = n.id
+    WHERE o.is_active <> n.is_active
+    ORDER BY n.id;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER trg_pr_insert_log
+    AFTER INSERT ON prmanager.pull_requests
+    REFERENCING NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_created();
+
+CREATE TRIGGER trg_pr_update_log
+    AFTER UPDATE ON prmanager.pull_requests
+    REFERENCING OLD TABLE AS old_prs NEW TABLE AS new_prs
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_pr_merged();
+
+CREATE TRIGGER trg_reviewers_insert_log
+    AFTER INSERT ON prmanager.reviewers
+    REFERENCING NEW TABLE AS new_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_assigned();
+
+CREATE TRIGGER trg_reviewers_delete_log
+    AFTER DELETE ON prmanager.reviewers
+    REFERENCING OLD TABLE AS old_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_unassigned();
+
+CREATE TRIGGER trg_reviewers_update_log
+    AFTER UPDATE ON prmanager.reviewers
+    REFERENCING OLD TABLE AS old_reviewers NEW TABLE AS new_reviewers
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_reviewers_swapped();
+
+CREATE TRIGGER trg_users_update_log
+    AFTER UPDATE ON prmanager.users
+    REFERENCING OLD TABLE AS old_users NEW TABLE AS new_users
+    FOR EACH STATEMENT EXECUTE FUNCTION prmanager.log_users_activity();
+
+-- Moves the PRs merged in `merged_month` (UTC) and their reviewers out of
+-- the hot partitions into new partitions of that month; returns the number
+-- of PRs moved. Rows are copied into plain tables that are attached
+-- afterwards, so no triggers fire: the event feed and updated_at stay as
+-- they are. A month is archived once, later calls for it return 0.
+CREATE FUNCTION prmanager.archive_merged_month(merged_month DATE)
+RETURNS BIGINT AS $$
+DECLARE
+    month_start TIMESTAMPTZ := merged_month::timestamp AT TIME ZONE 'UTC';
+    month_end TIMESTAMPTZ :=
+        (merged_month + INTERVAL '1 month') AT TIME ZONE 'UTC';
+    bound TEXT := to_char(merged_month, 'YYYY-MM-DD');
+    pr_table TEXT := 'pull_requests_' || to_char(merged_month, 'YYYY_MM');
+    reviewers_table TEXT := 'reviewers_' || to_char(merged_month, 'YYYY_MM');
+    moved BIGINT;
+BEGIN
+    -- Every instance runs the job; the others wait and find the month done.
+    PERFORM pg_advisory_xact_lock(hashtext('prmanager.archive_merged_month'));
+    IF to_regclass('prmanager.' || pr_table) IS NOT NULL THEN
+        RETURN 0;
+    END IF;
+
+    EXECUTE format('CREATE TABLE prmanager.%I (LIKE prmanager.pull_requests '
+                   'INCLUDING DEFAULTS INCLUDING CONSTRAINTS)', pr_table);
+    EXECUTE format('CREATE TABLE prmanager.%I (LIKE prmanager.reviewers '
+                   'INCLUDING DEFAULTS INCLUDING CONSTRAINTS)',
+                   reviewers_table);
+
+    -- Reviewers first, deleting the PRs would cascade to them.
+    EXECUTE format(
+        'WITH moved AS ('
+        '  DELETE FROM prmanager.reviewers_hot r '
+        '  USING prmanager.pull_requests_hot pr '
+        '  WHERE r.pull_request_uid = pr.uid AND pr.status = ''MERGED'' '
+        '  AND pr.merged_at >= $1 AND pr.merged_at < $2 '
+        '  RETURNING r.pull_request_uid, r.reviewer_uid, r.assigned_at'
+        ') INSERT INTO prmanager.%I '
+        '(pull_request_uid, reviewer_uid, assigned_at, archived_month) '
+        'SELECT pull_request_uid, reviewer_uid, assigned_at, $3 FROM moved',
+        reviewers_table) USING month_start, month_end, merged_month;
+    EXECUTE format(
+        'WITH moved AS ('
+        '  DELETE FROM prmanager.pull_requests_hot '
+        '  WHERE status = ''MERGED'' '
+        '  AND merged_at >= $1 AND merged_at < $2 '
+        '  RETURNING id, uid, name, author_id, status, created_at, '
+        '  merged_at, updated_at'
+        ') INSERT INTO prmanager.%I '
+        '(id, uid, name, author_id, status, created_at, merged_at, '
+        'updated_at, archived_month) '
+        'SELECT id, uid, name, author_id, status, created_at, merged_at, '
+        'updated_at, $3 FROM moved',
+        pr_table) USING month_start, month_end, merged_month;
+    GET DIAGNOSTICS moved = ROW_COUNT;
+
+    -- Builds the indexes and checks the foreign keys of the new partitions.
+    EXECUTE format('ALTER TABLE prmanager.pull_requests ATTACH PARTITION '
+                   'prmanager.%I FOR VALUES IN (%L)', pr_table, bound);
+    EXECUTE format('ALTER TABLE prmanager.reviewers ATTACH PARTITION '
+                   'prmanager.%I FOR VALUES IN (%L)', reviewers_table, bound);
+    RETURN moved;
+END;
+$$ LANGUAGE plpgsql;
@@ -0,0 +1,180 @@
+#include "event_feed.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "../db/queries.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::size_t kDefaultBufferSize = 100000;
+constexpr std::size_t kDefaultPollBatchSize = 1000;
+constexpr std::chrono::milliseconds kDefaultPollInterval{100};
+
+std::int64_t SelectLastSeq(userver::storages::postgres::Cluster& cluster) {
+  auto res = cluster.Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      db::kSelectLastEventSeq);
+  return res[0]["seq"].As<std::int64_t>();
+}
+
+std::vector<models::Event> ParseEvents(
+    const userver::storages::postgres::ResultSet& res) {
+  std::vector<models::Event> events;
+  events.reserve(res.Size());
+  for (const auto& row : res) {
+    events.push_back(models::Event{
+        row["seq"].As<std::int64_t>(), row["type"].As<std::string>(),
+        row["pull_request_id"].As<std::optional<std::string>>(),
+        row["user_id"].As<std::optional<std::string>>(),
+        userver::utils::datetime::Timestring(
+            row["created_at"]
+                .As<userver::storages::postgres::TimePointTz>()
+                .GetUnderlying())});
+  }
+  return events;
+}
+
+}  // namespace
+
+EventFeed::EventFeed(const userver::components::ComponentConfig& config,
+                     const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      metrics_(metrics::GetMetrics(context)),
+      buffer_size_(config["buffer-size"].As<std::size_t>(kDefaultBufferSize)),
+      poll_batch_size_(config["poll-batch-size"].As<std::size_t>(
+          kDefaultPollBatchSize)),
+      log_(buffer_size_, SelectLastSeq(*pg_cluster_)) {
+  poll_task_.Start(
+      "event-feed-poll",
+      userver::utils::PeriodicTask::Settings{
+          config["poll-interval"].As<std::chrono::milliseconds>(
+              kDefaultPollInterval)},
+      [this] { Poll(); });
+  reset_registration_ = userver::testsuite::RegisterCache(
+      config, context, this, &EventFeed::Reset);
+}
+
+EventFeed::~EventFeed() { poll_task_.Stop(); }
+
+userver::yaml_config::Schema EventFeed::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: change feed served by /events
+additionalProperties: false
+properties:
+    buffer-size:
+        type: integer
+        description: number of recent events kept in memory
+        defaultDescription: 100000
+        minimum: 1
+    poll-interval:
+        type: string
+        description: how often the events table is read for new rows
+        defaultDescription: 100ms
+    poll-batch-size:
+        type: integer
+        description: rows read per query while catching up
+        defaultDescription: 1000
+        minimum: 1
+)");
+}
+
+std::int64_t EventFeed::GetHead() const {
+  std::lock_guard lock(mutex_);
+  return log_.GetHead();
+}
+
+EventFeed::Page EventFeed::Read(std::int64_t since, std::size_t limit,
+                                std::chrono::milliseconds wait) {
+  std::unique_lock lock(mutex_);
+  if (log_.GetHead() <= since) {
+    // Timeouts and cancellations both end with an empty page.
+    [[maybe_unused]] const bool appended = appended_.WaitUntil(
+        lock, userver::engine::Deadline::FromDuration(wait),
+        [&] { return log_.GetHead() > since; });
+  }
+
+  const auto head = log_.GetHead();
+  if (!log_.Covers(since)) {
+    lock.unlock();
+    return ReadFromDatabase(since, head, limit);
+  }
+  Page page{log_.Read(since, limit), std::max(since, head)};
+  if (!page.events.empty() && page.events.size() == limit) {
+    page.next_since = page.events.back().seq;
+  }
+  return page;
+}
+
+void EventFeed::Poll() {
+  while (true) {
+    const auto head = GetHead();
+    const auto res = pg_cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kMaster,
+        db::kSelectEvents, head, std::numeric_limits<std::int64_t>::max(),
+        static_cast<std::int64_t>(poll_batch_size_));
+    if (res.IsEmpty()) {
+      return;
+    }
+    const auto events = ParseEvents(res);
+    const auto& first = res[0];
+    const models::Snapshot snapshot{
+        static_cast<std::uint64_t>(first["snapshot_xmin"].As<std::int64_t>()),
+        static_cast<std::uint64_t>(first["snapshot_xmax"].As<std::int64_t>())};
+
+    std::size_t appended = 0;
+    {
+      std::lock_guard lock(mutex_);
+      appended = log_.Append(events, snapshot);
+    }
+    if (appended > 0) {
+      appended_.NotifyAll();
+    }
+    if (appended == 0 || events.size() < poll_batch_size_) {
+      return;
+    }
+  }
+}
+
+void EventFeed::Reset() {
+  const auto head = SelectLastSeq(*pg_cluster_);
+  std::lock_guard lock(mutex_);
+  log_ = models::EventLog{buffer_size_, head};
+}
+
+// Only events up to the head of the buffer: the ones after it have not
+// been checked for gaps yet.
+EventFeed::Page EventFeed::ReadFromDatabase(std::int64_t since,
+                                            std::int64_t head,
+                                            std::size_t limit) {
+  metrics::RequestScope scope{metrics_, "events_load"};
+  Page page{ParseEvents(scope.Execute(
+                *pg_cluster_,
+                userver::storages::postgres::ClusterHostType::kMaster,
+                db::kSelectEvents, since, head,
+                static_cast<std::int64_t>(limit))),
+            head};
+  if (!page.events.empty() && page.events.size() == limit) {
+    page.next_since = page.events.back().seq;
+  }
+  return page;
+}
+
+}  // namespace prmanager::components
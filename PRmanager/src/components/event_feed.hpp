@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <userver/components/component_base.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/testsuite/cache_control.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../metrics/request_metrics.hpp"
+#include "../models/event_log.hpp"
+
+namespace prmanager::components {
+
+// Tails the events table into an in-memory ring buffer and serves long
+// polls from it. Offsets older than the buffer are read from the database,
+// but never past the head of the buffer, so all readers see the same order.
+class EventFeed final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "event-feed";
+
+  struct Page {
+    std::vector<models::Event> events;
+    // Pass as `since` to get the next page.
+    std::int64_t next_since;
+  };
+
+  EventFeed(const userver::components::ComponentConfig& config,
+            const userver::components::ComponentContext& context);
+  ~EventFeed() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  std::int64_t GetHead() const;
+
+  // Waits up to `wait` for events after `since` if there are none yet.
+  Page Read(std::int64_t since, std::size_t limit,
+            std::chrono::milliseconds wait);
+
+ private:
+  void Poll();
+  // Starts over from the current end of the table; testsuite calls it
+  // between tests, after the database has been refilled.
+  void Reset();
+  Page ReadFromDatabase(std::int64_t since, std::int64_t head,
+                        std::size_t limit);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  metrics::Metrics& metrics_;
+  const std::size_t buffer_size_;
+  const std::size_t poll_batch_size_;
+
+  mutable userver::engine::Mutex mutex_;
+  userver::engine::ConditionVariable appended_;
+  models::EventLog log_;
+
+  userver::utils::PeriodicTask poll_task_;
+  userver::testsuite::CacheResetRegistration reset_registration_;
+};
+
+}  // namespace prmanager::components
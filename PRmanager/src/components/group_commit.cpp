@@ -0,0 +1,180 @@
+#include "group_commit.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::size_t kDefaultMaxBatchSize = 64;
+constexpr std::chrono::milliseconds kDefaultMaxDelay{2};
+constexpr std::size_t kDefaultFlushers = 2;
+// Requests wait in Push() once this many statements are queued.
+constexpr std::size_t kQueueSize = 10000;
+
+}  // namespace
+
+GroupCommit::GroupCommit(const userver::components::ComponentConfig& config,
+                         const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      metrics_(metrics::GetMetrics(context)),
+      enabled_(config["enabled"].As<bool>(false)),
+      max_batch_size_(
+          config["max-batch-size"].As<std::size_t>(kDefaultMaxBatchSize)),
+      max_delay_(config["max-delay"].As<std::chrono::milliseconds>(
+          kDefaultMaxDelay)) {
+  if (!enabled_) {
+    return;
+  }
+
+  queue_ = Queue::Create(kQueueSize);
+  producer_.emplace(queue_->GetMultiProducer());
+  const auto flushers = config["flushers"].As<std::size_t>(kDefaultFlushers);
+  for (std::size_t i = 0; i < flushers; ++i) {
+    flushers_.push_back(userver::utils::CriticalAsync(
+        "group-commit-flush",
+        [this, consumer = queue_->GetMultiConsumer()]() mutable {
+          Flush(std::move(consumer));
+        }));
+  }
+}
+
+GroupCommit::~GroupCommit() {
+  // Flushers drain the queue and stop once the last producer is gone.
+  producer_.reset();
+  for (auto& flusher : flushers_) {
+    flusher.Get();
+  }
+}
+
+userver::yaml_config::Schema GroupCommit::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: group commit of create and merge statements
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: batch statements of concurrent requests
+        defaultDescription: false
+    max-batch-size:
+        type: integer
+        description: statements per transaction
+        defaultDescription: 64
+        minimum: 1
+    max-delay:
+        type: string
+        description: how long the first statement of a batch waits for others
+        defaultDescription: 2ms
+    flushers:
+        type: integer
+        description: number of batches committed concurrently
+        defaultDescription: 2
+        minimum: 1
+)");
+}
+
+userver::storages::postgres::ResultSet GroupCommit::Execute(
+    const std::string& lock_key,
+    const userver::storages::postgres::Query& query,
+    userver::storages::postgres::ParameterStore params) {
+  if (!enabled_) {
+    return pg_cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kMaster, query, params);
+  }
+
+  auto statement = std::make_unique<Statement>(
+      Statement{lock_key, query, std::move(params), {}});
+  auto result = statement->result.get_future();
+  if (!producer_->Push(std::move(statement))) {
+    throw std::runtime_error("group commit is shutting down");
+  }
+  return result.get();
+}
+
+void GroupCommit::Flush(Queue::Consumer consumer) {
+  std::unique_ptr<Statement> statement;
+  while (consumer.Pop(statement)) {
+    std::vector<std::unique_ptr<Statement>> batch;
+    batch.push_back(std::move(statement));
+    const auto deadline =
+        userver::engine::Deadline::FromDuration(max_delay_);
+    while (batch.size() < max_batch_size_ &&
+           consumer.Pop(statement, deadline)) {
+      batch.push_back(std::move(statement));
+    }
+    Commit(batch);
+  }
+}
+
+void GroupCommit::Commit(std::vector<std::unique_ptr<Statement>>& batch) {
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return lhs->lock_key < rhs->lock_key;
+                   });
+
+  std::vector<userver::storages::postgres::ResultSet> results;
+  results.reserve(batch.size());
+  std::exception_ptr commit_error;
+  try {
+    metrics::RequestScope scope{metrics_, "group_commit"};
+    // Candidates of this operation are the batch sizes.
+    scope.AccountCandidates(batch.size());
+    auto trx = scope.Begin(
+        *pg_cluster_, "group_commit",
+        userver::storages::postgres::ClusterHostType::kMaster);
+    try {
+      for (const auto& statement : batch) {
+        results.push_back(
+            scope.Execute(trx, statement->query, statement->params));
+      }
+    } catch (const std::exception&) {
+      trx.Rollback();
+      throw;
+    }
+    try {
+      scope.Commit(trx);
+    } catch (const std::exception& e) {
+      LOG_ERROR() << "Commit of a group of " << batch.size()
+                  << " statements failed with an unknown outcome: " << e;
+      commit_error = std::current_exception();
+    }
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Group commit of " << batch.size()
+                  << " statements failed, retrying one by one: " << e;
+    for (auto& statement : batch) {
+      try {
+        statement->result.set_value(pg_cluster_->Execute(
+            userver::storages::postgres::ClusterHostType::kMaster,
+            statement->query, statement->params));
+      } catch (const std::exception&) {
+        statement->result.set_exception(std::current_exception());
+      }
+    }
+    return;
+  }
+
+  if (commit_error) {
+    for (auto& statement : batch) {
+      statement->result.set_exception(commit_error);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    batch[i]->result.set_value(std::move(results[i]));
+  }
+}
+
+}  // namespace prmanager::components
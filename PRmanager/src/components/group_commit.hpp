@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/components/component_base.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::components {
+
+// Opt-in group commit for single-statement writes. When enabled, statements
+// of concurrent requests are queued and flushed in one master transaction
+// once `max-batch-size` of them are collected or `max-delay` passes, so a
+// burst of writes pays for one commit instead of one per request. When
+// disabled, Execute() runs the statement on the master right away.
+//
+// If a statement of the batch fails, the batch has rolled back and every
+// statement is retried in its own transaction to isolate the failing one.
+// If the commit itself fails, the batch may or may not have committed, so
+// nothing is retried and every caller gets the error.
+class GroupCommit final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "group-commit";
+
+  GroupCommit(const userver::components::ComponentConfig& config,
+              const userver::components::ComponentContext& context);
+  ~GroupCommit() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  // Returns after the statement's transaction has committed. Statements of a
+  // batch run ordered by `lock_key`, the id of the row they lock, so that
+  // concurrent batches do not deadlock on each other.
+  template <typename... Args>
+  userver::storages::postgres::ResultSet Execute(
+      const std::string& lock_key,
+      const userver::storages::postgres::Query& query, const Args&... args) {
+    userver::storages::postgres::ParameterStore params;
+    (params.PushBack(args), ...);
+    return Execute(lock_key, query, std::move(params));
+  }
+
+  userver::storages::postgres::ResultSet Execute(
+      const std::string& lock_key,
+      const userver::storages::postgres::Query& query,
+      userver::storages::postgres::ParameterStore params);
+
+ private:
+  struct Statement {
+    std::string lock_key;
+    userver::storages::postgres::Query query;
+    userver::storages::postgres::ParameterStore params;
+    userver::engine::Promise<userver::storages::postgres::ResultSet> result;
+  };
+
+  using Queue =
+      userver::concurrent::NonFifoMpmcQueue<std::unique_ptr<Statement>>;
+
+  void Flush(Queue::Consumer consumer);
+  void Commit(std::vector<std::unique_ptr<Statement>>& batch);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  metrics::Metrics& metrics_;
+  const bool enabled_;
+  const std::size_t max_batch_size_;
+  const std::chrono::milliseconds max_delay_;
+  std::shared_ptr<Queue> queue_;
+  std::optional<Queue::Producer> producer_;
+  std::vector<userver::engine::TaskWithResult<void>> flushers_;
+};
+
+}  // namespace prmanager::components
@@ -0,0 +1,183 @@
+#include "idempotency_cache.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <mutex>
+
+#include "../db/consistency.hpp"
+#include "../models/response.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::size_t kDefaultSize = 100000;
+constexpr std::size_t kDefaultWays = 16;
+constexpr std::chrono::seconds kDefaultLifetime{600};
+constexpr std::size_t kMaxKeyLength = 255;
+
+std::size_t GetWaySize(const userver::components::ComponentConfig& config) {
+  const auto size = config["size"].As<std::size_t>(kDefaultSize);
+  const auto ways = config["ways"].As<std::size_t>(kDefaultWays);
+  return (size + ways - 1) / ways;
+}
+
+}  // namespace
+
+IdempotencyCache::IdempotencyCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      cache_(config["ways"].As<std::size_t>(kDefaultWays),
+             GetWaySize(config)),
+      running_shards_(config["ways"].As<std::size_t>(kDefaultWays)) {
+  cache_.SetMaxLifetime(config["lifetime"].As<std::chrono::milliseconds>(
+      kDefaultLifetime));
+  reset_registration_ = userver::testsuite::RegisterCache(
+      config, context, this, &IdempotencyCache::Clear);
+}
+
+userver::yaml_config::Schema IdempotencyCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: responses of write requests by idempotency key
+additionalProperties: false
+properties:
+    size:
+        type: integer
+        description: maximum number of stored responses
+        defaultDescription: 100000
+        minimum: 1
+    ways:
+        type: integer
+        description: |
+            number of independently locked LRU shards, also used for the
+            requests still running
+        defaultDescription: 16
+        minimum: 1
+    lifetime:
+        type: string
+        description: how long a retry is answered from memory
+        defaultDescription: 10m
+)");
+}
+
+std::string IdempotencyCache::Handle(
+    const userver::server::http::HttpRequest& request,
+    const std::function<std::string()>& handler) {
+  const auto& key_header = request.GetHeader(kIdempotencyKeyHeader);
+  if (key_header.empty()) {
+    return handler();
+  }
+  if (key_header.size() > kMaxKeyLength) {
+    throw userver::server::handlers::ClientError(
+        userver::server::handlers::ExternalBody{"Idempotency key is too long"});
+  }
+
+  const auto key = request.GetRequestPath() + ' ' + key_header;
+  const auto fingerprint = std::hash<std::string>{}(request.RequestBody());
+  if (const auto cached = cache_.GetOptionalNoUpdate(key)) {
+    return Replay(request, **cached, fingerprint);
+  }
+
+  {
+    auto& shard = GetShard(key);
+    std::unique_lock lock(shard.mutex);
+    while (true) {
+      // Checked under the lock: Release() stores before it wakes anyone.
+      if (const auto cached = cache_.GetOptionalNoUpdate(key)) {
+        lock.unlock();
+        return Replay(request, **cached, fingerprint);
+      }
+      const auto [it, inserted] = shard.running.emplace(key, fingerprint);
+      if (inserted) {
+        break;
+      }
+      if (it->second != fingerprint) {
+        lock.unlock();
+        return RejectReusedKey(request);
+      }
+      if (!shard.released.Wait(lock,
+                               [&] { return !shard.running.count(key); })) {
+        throw userver::engine::WaitInterruptedException(
+            userver::engine::current_task::CancellationReason());
+      }
+    }
+  }
+
+  std::string body;
+  try {
+    body = handler();
+  } catch (const std::exception&) {
+    Release(key, nullptr);
+    throw;
+  }
+
+  const auto& response = request.GetHttpResponse();
+  const auto status = response.GetStatus();
+  if (static_cast<int>(status) >= 500) {
+    Release(key, nullptr);
+    return body;
+  }
+  std::string token;
+  if (response.HasHeader(db::kConsistencyTokenHeader)) {
+    token = response.GetHeader(db::kConsistencyTokenHeader);
+  }
+  Release(key, std::make_shared<Response>(
+                   Response{fingerprint, status, body, std::move(token)}));
+  return body;
+}
+
+std::string IdempotencyCache::Replay(
+    const userver::server::http::HttpRequest& request,
+    const Response& response, std::size_t fingerprint) {
+  if (response.fingerprint != fingerprint) {
+    return RejectReusedKey(request);
+  }
+  request.SetResponseStatus(response.status);
+  auto& http_response = request.GetHttpResponse();
+  http_response.SetHeader(std::string{kIdempotentReplayedHeader},
+                          std::string{"true"});
+  if (!response.consistency_token.empty()) {
+    http_response.SetHeader(std::string{db::kConsistencyTokenHeader},
+                            response.consistency_token);
+  }
+  return response.body;
+}
+
+std::string IdempotencyCache::RejectReusedKey(
+    const userver::server::http::HttpRequest& request) {
+  request.SetResponseStatus(
+      userver::server::http::HttpStatus::kUnprocessableEntity);
+  return models::ToJsonString(models::ErrorResponse{
+      "IDEMPOTENCY_KEY_REUSED",
+      "idempotency key was used with another request body"});
+}
+
+IdempotencyCache::RunningShard& IdempotencyCache::GetShard(
+    const std::string& key) {
+  return running_shards_[std::hash<std::string>{}(key) %
+                         running_shards_.size()];
+}
+
+void IdempotencyCache::Release(const std::string& key, ResponsePtr response) {
+  auto& shard = GetShard(key);
+  {
+    std::lock_guard lock(shard.mutex);
+    if (response) {
+      cache_.Put(key, std::move(response));
+    }
+    shard.running.erase(key);
+  }
+  shard.released.NotifyAll();
+}
+
+void IdempotencyCache::Clear() { cache_.Invalidate(); }
+
+}  // namespace prmanager::components
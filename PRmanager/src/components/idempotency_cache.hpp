@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/components/component_base.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/testsuite/cache_control.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+namespace prmanager::components {
+
+inline constexpr std::string_view kIdempotencyKeyHeader = "Idempotency-Key";
+// Set on responses that were replayed from the cache.
+inline constexpr std::string_view kIdempotentReplayedHeader =
+    "Idempotent-Replayed";
+
+// Responses of write requests that carried an Idempotency-Key, kept per
+// endpoint and key. A retry gets the stored response without running the
+// handler again; a duplicate that arrives while the first request is still
+// running waits for it. Keys are local to this instance.
+class IdempotencyCache final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "idempotency-cache";
+
+  IdempotencyCache(const userver::components::ComponentConfig& config,
+                   const userver::components::ComponentContext& context);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  // Runs handler unless the request is a retry. Responses with a 5xx status
+  // and exceptions are not stored, so the next retry runs the handler.
+  std::string Handle(const userver::server::http::HttpRequest& request,
+                     const std::function<std::string()>& handler);
+
+ private:
+  struct Response {
+    // Hash of the request body; a key reused for another body is an error.
+    std::size_t fingerprint;
+    userver::server::http::HttpStatus status;
+    std::string body;
+    std::string consistency_token;
+  };
+  using ResponsePtr = std::shared_ptr<const Response>;
+
+  // Keys whose first request is still running, with its body fingerprint.
+  // Sharded by key hash like the LRU ways, so that unrelated keys neither
+  // contend for the mutex nor wake each other's waiters.
+  struct RunningShard {
+    userver::engine::Mutex mutex;
+    userver::engine::ConditionVariable released;
+    std::unordered_map<std::string, std::size_t> running;
+  };
+
+  static std::string Replay(const userver::server::http::HttpRequest& request,
+                            const Response& response, std::size_t fingerprint);
+  static std::string RejectReusedKey(
+      const userver::server::http::HttpRequest& request);
+  RunningShard& GetShard(const std::string& key);
+  void Release(const std::string& key, ResponsePtr response);
+  // Drops everything; testsuite calls it between tests.
+  void Clear();
+
+  userver::cache::ExpirableLruCache<std::string, ResponsePtr> cache_;
+
+  std::vector<RunningShard> running_shards_;
+
+  userver::testsuite::CacheResetRegistration reset_registration_;
+};
+
+}  // namespace prmanager::components
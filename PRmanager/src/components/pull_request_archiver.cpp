@@ -0,0 +1,82 @@
+#include "pull_request_archiver.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include "../db/queries.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::chrono::hours kDefaultArchiveAfter{24 * 90};
+constexpr std::chrono::hours kDefaultInterval{1};
+
+}  // namespace
+
+PullRequestArchiver::PullRequestArchiver(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      metrics_(metrics::GetMetrics(context)),
+      archive_after_(config["archive-after"].As<std::chrono::milliseconds>(
+          kDefaultArchiveAfter)) {
+  archive_task_.Start(
+      "pull-request-archiver",
+      userver::utils::PeriodicTask::Settings{
+          config["interval"].As<std::chrono::milliseconds>(kDefaultInterval)},
+      [this] { Archive(); });
+}
+
+PullRequestArchiver::~PullRequestArchiver() { archive_task_.Stop(); }
+
+userver::yaml_config::Schema PullRequestArchiver::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: moves long merged PRs into monthly archive partitions
+additionalProperties: false
+properties:
+    archive-after:
+        type: string
+        description: |
+            merged PRs stay in the hot partitions until their merge month
+            ended at least this long ago
+        defaultDescription: 2160h
+    interval:
+        type: string
+        description: how often the hot partitions are checked
+        defaultDescription: 1h
+)");
+}
+
+void PullRequestArchiver::Archive() {
+  metrics::RequestScope scope{metrics_, "pr_archive"};
+  const userver::storages::postgres::TimePointTz cutoff{
+      userver::utils::datetime::Now() - archive_after_};
+  const auto months = scope.Execute(
+      *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+      db::kSelectArchivableMonths, cutoff);
+
+  // Oldest first, one transaction per month.
+  for (const auto& row : months) {
+    const auto month = row["month"].As<std::string>();
+    const auto res = scope.Execute(
+        *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+        db::kArchiveMergedMonth, month);
+    LOG_INFO() << "Archived " << res[0]["moved"].As<std::int64_t>()
+               << " pull requests merged in " << month;
+  }
+}
+
+}  // namespace prmanager::components
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+#include <userver/components/component_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::components {
+
+// Moves PRs merged in months that ended more than `archive-after` ago out
+// of the hot partitions, one month partition at a time (see
+// 009_archive_partitions.sql). Every instance runs it; the database
+// function serializes them.
+class PullRequestArchiver final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "pull-request-archiver";
+
+  PullRequestArchiver(const userver::components::ComponentConfig& config,
+                      const userver::components::ComponentContext& context);
+  ~PullRequestArchiver() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Archive();
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  metrics::Metrics& metrics_;
+  const std::chrono::milliseconds archive_after_;
+  userver::utils::PeriodicTask archive_task_;
+};
+
+}  // namespace prmanager::components
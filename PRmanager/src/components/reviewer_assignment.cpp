@@ -0,0 +1,163 @@
+#include "reviewer_assignment.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "../db/queries.hpp"
+#include "../utils/random.hpp"
+#include "team_roster_cache.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::chrono::seconds kDefaultReloadInterval{60};
+
+}  // namespace
+
+ReviewerAssignment::Reservation::Reservation(
+    ReviewerAssignment& owner, std::vector<std::string> reviewers,
+    std::size_t pool_size)
+    : owner_(&owner), reviewers_(std::move(reviewers)), pool_size_(pool_size) {}
+
+ReviewerAssignment::Reservation::Reservation(Reservation&& other) noexcept
+    : owner_(std::exchange(other.owner_, nullptr)),
+      reviewers_(std::move(other.reviewers_)),
+      pool_size_(other.pool_size_) {}
+
+ReviewerAssignment::Reservation::~Reservation() {
+  if (owner_) {
+    owner_->Unassign(reviewers_);
+  }
+}
+
+const std::vector<std::string>&
+ReviewerAssignment::Reservation::GetReviewers() const {
+  return reviewers_;
+}
+
+std::size_t ReviewerAssignment::Reservation::GetPoolSize() const {
+  return pool_size_;
+}
+
+void ReviewerAssignment::Reservation::Commit() { owner_ = nullptr; }
+
+ReviewerAssignment::ReviewerAssignment(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()) {
+  if (const auto seed =
+          config["random-seed"].As<std::optional<std::uint64_t>>()) {
+    utils::SetDeterministicSeed(*seed);
+  }
+  Reload();
+  roster_subscription_ =
+      context.FindComponent<TeamRosterCache>().UpdateAndListen(
+          this, kName, &ReviewerAssignment::OnRosterUpdate);
+  reload_task_.Start(
+      "reviewer-assignment-reload",
+      userver::utils::PeriodicTask::Settings{
+          config["reload-interval"].As<std::chrono::milliseconds>(
+              kDefaultReloadInterval)},
+      [this] { Reload(); });
+}
+
+ReviewerAssignment::~ReviewerAssignment() {
+  reload_task_.Stop();
+  roster_subscription_.Unsubscribe();
+}
+
+userver::yaml_config::Schema ReviewerAssignment::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: least loaded reviewer picking
+additionalProperties: false
+properties:
+    reload-interval:
+        type: string
+        description: how often open review counts are reloaded from the database
+        defaultDescription: 60s
+    random-seed:
+        type: integer
+        description: |
+            fixed seed for the tie-breaking generator, makes reviewer picks
+            reproducible in tests
+        minimum: 0
+)");
+}
+
+ReviewerAssignment::Reservation ReviewerAssignment::Reserve(
+    const std::string& team_name, std::size_t count,
+    const IsExcluded& is_excluded) {
+  std::lock_guard lock(mutex_);
+  auto reviewers = index_.PickLeastLoaded(team_name, count, is_excluded);
+  for (const auto& user_id : reviewers) {
+    index_.AddLoad(user_id, 1);
+  }
+  return Reservation{*this, std::move(reviewers),
+                     index_.GetActiveCount(team_name)};
+}
+
+void ReviewerAssignment::Assign(const std::vector<std::string>& user_ids) {
+  AddLoad(user_ids, 1);
+}
+
+void ReviewerAssignment::Unassign(const std::vector<std::string>& user_ids) {
+  AddLoad(user_ids, -1);
+}
+
+std::int64_t ReviewerAssignment::GetLoad(const std::string& user_id) const {
+  std::lock_guard lock(mutex_);
+  return index_.GetLoad(user_id);
+}
+
+void ReviewerAssignment::OnRosterUpdate(
+    const std::shared_ptr<const models::TeamRoster>& roster) {
+  // Only members changed by the snapshot are applied. Every snapshot is
+  // delivered in order, and membership older than the subscription comes
+  // from Reload() in the constructor.
+  std::lock_guard lock(mutex_);
+  for (const auto* member : roster->GetChanges()) {
+    index_.SetMember(member->user_id, member->team_name, member->is_active);
+  }
+}
+
+void ReviewerAssignment::Reload() {
+  // Writes that commit while the query runs may be counted twice or not at
+  // all until the next reload; loads only steer the choice, so that is fine.
+  auto res = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      db::kSelectReviewLoads);
+
+  std::lock_guard lock(mutex_);
+  for (const auto& row : res) {
+    const auto user_id = row["id"].As<std::string>();
+    index_.SetMember(user_id, row["team_name"].As<std::string>(),
+                     row["is_active"].As<bool>());
+    index_.SetLoad(user_id, row["open_reviews"].As<std::int64_t>());
+  }
+}
+
+void ReviewerAssignment::AddLoad(const std::vector<std::string>& user_ids,
+                                 std::int64_t delta) {
+  if (user_ids.empty()) {
+    return;
+  }
+
+  std::lock_guard lock(mutex_);
+  for (const auto& user_id : user_ids) {
+    index_.AddLoad(user_id, delta);
+  }
+}
+
+}  // namespace prmanager::components
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/components/component_base.hpp>
+#include <userver/concurrent/async_event_source.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../models/review_load_index.hpp"
+#include "../models/team_roster.hpp"
+
+namespace prmanager::components {
+
+// Picks the least loaded active reviewers of a team. Membership follows the
+// team roster cache, open review counts are updated by the handlers of this
+// instance and periodically reloaded to pick up writes of other instances.
+class ReviewerAssignment final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "reviewer-assignment";
+
+  // Reserved reviewers count as loaded right away, so that concurrent
+  // requests spread over different people. Unless Commit() is called after
+  // the database write, the load is given back on destruction.
+  class Reservation final {
+   public:
+    Reservation(Reservation&& other) noexcept;
+    Reservation& operator=(Reservation&&) = delete;
+    ~Reservation();
+
+    const std::vector<std::string>& GetReviewers() const;
+
+    // Active members of the team, excluded ones included.
+    std::size_t GetPoolSize() const;
+
+    void Commit();
+
+   private:
+    friend class ReviewerAssignment;
+
+    Reservation(ReviewerAssignment& owner, std::vector<std::string> reviewers,
+                std::size_t pool_size);
+
+    ReviewerAssignment* owner_;
+    std::vector<std::string> reviewers_;
+    std::size_t pool_size_;
+  };
+
+  using IsExcluded = std::function<bool(const std::string&)>;
+
+  ReviewerAssignment(const userver::components::ComponentConfig& config,
+                     const userver::components::ComponentContext& context);
+  ~ReviewerAssignment() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  Reservation Reserve(const std::string& team_name, std::size_t count,
+                      const IsExcluded& is_excluded);
+
+  // Reviewers assigned without a reservation, e.g. picked by the database.
+  void Assign(const std::vector<std::string>& user_ids);
+
+  // Reviewers removed from an open PR or released by a merge.
+  void Unassign(const std::vector<std::string>& user_ids);
+
+  std::int64_t GetLoad(const std::string& user_id) const;
+
+ private:
+  void OnRosterUpdate(const std::shared_ptr<const models::TeamRoster>& roster);
+  void Reload();
+  void AddLoad(const std::vector<std::string>& user_ids, std::int64_t delta);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  mutable userver::engine::Mutex mutex_;
+  models::ReviewLoadIndex index_;
+  userver::utils::PeriodicTask reload_task_;
+  userver::concurrent::AsyncEventSubscriberScope roster_subscription_;
+};
+
+}  // namespace prmanager::components
@@ -0,0 +1,126 @@
+#include "stats_aggregates_cache.hpp"
+
+#include <userver/cache/update_type.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../db/queries.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::size_t kEventsBatchSize = 1000;
+
+std::optional<std::chrono::system_clock::time_point> ParseOptionalTime(
+    const userver::storages::postgres::Field& field) {
+  const auto value =
+      field.As<std::optional<userver::storages::postgres::TimePointTz>>();
+  if (!value) {
+    return std::nullopt;
+  }
+  return value->GetUnderlying();
+}
+
+void ApplyRows(models::StatsAggregates& aggregates,
+               const userver::storages::postgres::ResultSet& res) {
+  for (const auto& row : res) {
+    aggregates.Apply(
+        row["id"].As<std::string>(),
+        models::PullRequestState{
+            row["status"].As<std::string>(),
+            row["team_name"].As<std::string>(),
+            row["reviewers"].As<std::vector<std::string>>(),
+            ParseOptionalTime(row["created_at"]),
+            ParseOptionalTime(row["merged_at"])});
+  }
+}
+
+}  // namespace
+
+StatsAggregatesCache::StatsAggregatesCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      event_feed_(context.FindComponent<EventFeed>()) {
+  CacheUpdateTrait::StartPeriodicUpdates();
+}
+
+StatsAggregatesCache::~StatsAggregatesCache() {
+  CacheUpdateTrait::StopPeriodicUpdates();
+}
+
+void StatsAggregatesCache::Update(
+    userver::cache::UpdateType type,
+    const std::chrono::system_clock::time_point& /*last_update*/,
+    const std::chrono::system_clock::time_point& /*now*/,
+    userver::cache::UpdateStatisticsScope& stats_scope) {
+  // The feed starts over below the cursor when testsuite resets it.
+  const bool is_full = type == userver::cache::UpdateType::kFull ||
+                       Get()->GetEventsHead() > event_feed_.GetHead();
+
+  // Rows are read from the master: they must be at least as new as the
+  // events that named them.
+  if (is_full) {
+    auto aggregates = std::make_unique<models::StatsAggregates>();
+    // Taken before the read, so later events read their PRs again.
+    aggregates->SetEventsHead(event_feed_.GetHead());
+    const auto res = pg_cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kMaster,
+        db::kSelectStatsPullRequests);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+    ApplyRows(*aggregates, res);
+    const auto size = aggregates->GetOpenCount() + aggregates->GetMergedCount();
+    Set(std::move(aggregates));
+    stats_scope.Finish(size);
+    return;
+  }
+
+  std::unique_ptr<models::StatsAggregates> aggregates;
+  auto since = Get()->GetEventsHead();
+  while (true) {
+    const auto page = event_feed_.Read(since, kEventsBatchSize,
+                                       std::chrono::milliseconds{0});
+    if (page.next_since == since) {
+      break;
+    }
+    std::unordered_set<std::string> pr_ids;
+    for (const auto& event : page.events) {
+      if (event.pull_request_id) {
+        pr_ids.insert(*event.pull_request_id);
+      }
+    }
+    if (!aggregates) {
+      aggregates = std::make_unique<models::StatsAggregates>(*Get());
+    }
+    if (!pr_ids.empty()) {
+      const auto res = pg_cluster_->Execute(
+          userver::storages::postgres::ClusterHostType::kMaster,
+          db::kSelectStatsPullRequestsByIds,
+          std::vector<std::string>{pr_ids.begin(), pr_ids.end()});
+      stats_scope.IncreaseDocumentsReadCount(res.Size());
+      ApplyRows(*aggregates, res);
+    }
+    since = page.next_since;
+    aggregates->SetEventsHead(since);
+  }
+
+  if (!aggregates) {
+    stats_scope.FinishNoChanges();
+    return;
+  }
+  const auto size = aggregates->GetOpenCount() + aggregates->GetMergedCount();
+  Set(std::move(aggregates));
+  stats_scope.Finish(size);
+}
+
+}  // namespace prmanager::components
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "../models/stats_aggregates.hpp"
+#include "event_feed.hpp"
+
+namespace prmanager::components {
+
+// Background aggregation of review load. Each tick reads the event feed
+// after the last applied event and applies the current state of the pull
+// requests it names. The feed only passes an event once every transaction
+// that could precede it has ended, so slow writers and replication do not
+// lose changes.
+class StatsAggregatesCache final
+    : public userver::components::CachingComponentBase<
+          models::StatsAggregates> {
+ public:
+  static constexpr std::string_view kName = "stats-aggregates-cache";
+
+  StatsAggregatesCache(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context);
+  ~StatsAggregatesCache() override;
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  EventFeed& event_feed_;
+};
+
+}  // namespace prmanager::components
@@ -0,0 +1,92 @@
+#include "stats_counters.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "../db/queries.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::chrono::seconds kDefaultReconcileInterval{60};
+
+}  // namespace
+
+std::int64_t StatsCounters::Counter::Load() const {
+  return base.load() + delta.load();
+}
+
+StatsCounters::StatsCounters(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()) {
+  Reconcile();
+  reconcile_task_.Start(
+      "stats-counters-reconcile",
+      userver::utils::PeriodicTask::Settings{
+          config["reconcile-interval"].As<std::chrono::milliseconds>(
+              kDefaultReconcileInterval)},
+      [this] { Reconcile(); });
+}
+
+StatsCounters::~StatsCounters() { reconcile_task_.Stop(); }
+
+userver::yaml_config::Schema StatsCounters::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: in-memory counters served by /stats
+additionalProperties: false
+properties:
+    reconcile-interval:
+        type: string
+        description: how often the counters are recomputed from the database
+        defaultDescription: 60s
+)");
+}
+
+models::StatsResponse StatsCounters::GetStats() const {
+  models::StatsResponse response;
+  response.teams_count = teams_.Load();
+  response.users_count = users_.Load();
+  response.prs_count = prs_.Load();
+  return response;
+}
+
+StatsCounters::WriteGuard StatsCounters::BeginWrite() {
+  return WriteGuard{reconcile_mutex_};
+}
+
+void StatsCounters::AddTeams(std::int64_t count) { teams_.delta += count; }
+
+void StatsCounters::AddUsers(std::int64_t count) { users_.delta += count; }
+
+void StatsCounters::AddPullRequests(std::int64_t count) {
+  prs_.delta += count;
+}
+
+void StatsCounters::Reconcile() {
+  // No write of this instance is between its commit and its delta while
+  // the lock is held. Writers wait for the count.
+  std::unique_lock lock(reconcile_mutex_);
+  const auto teams_delta = teams_.delta.load();
+  const auto users_delta = users_.delta.load();
+  const auto prs_delta = prs_.delta.load();
+
+  // Counts are read from the master so that deltas of already committed
+  // writes are not lost to replication lag.
+  auto res = pg_cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster, db::kCountRows);
+
+  const auto& row = res[0];
+  teams_.base = row["teams"].As<std::int64_t>() - teams_delta;
+  users_.base = row["users"].As<std::int64_t>() - users_delta;
+  prs_.base = row["prs"].As<std::int64_t>() - prs_delta;
+}
+
+}  // namespace prmanager::components
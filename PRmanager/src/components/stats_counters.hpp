@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+
+#include <userver/components/component_base.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../models/stats.hpp"
+
+namespace prmanager::components {
+
+// Exact row counters for /stats. Seeded from the database on start, kept up
+// to date by the handlers of this instance and periodically reconciled to
+// pick up changes made by other instances.
+//
+// Handlers hold a WriteGuard from before their commit until their delta is
+// added. A reconciliation takes the lock exclusively around the count and
+// the delta snapshot, so it sees every write of this instance either in
+// both or in neither.
+class StatsCounters final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "stats-counters";
+
+  using WriteGuard = std::shared_lock<userver::engine::SharedMutex>;
+
+  StatsCounters(const userver::components::ComponentConfig& config,
+                const userver::components::ComponentContext& context);
+  ~StatsCounters() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  models::StatsResponse GetStats() const;
+
+  // Take before committing a write that changes the counts, release after
+  // the Add*() calls.
+  WriteGuard BeginWrite();
+
+  void AddTeams(std::int64_t count);
+  void AddUsers(std::int64_t count);
+  void AddPullRequests(std::int64_t count);
+
+ private:
+  struct Counter {
+    // Value read from the database by the last reconciliation, minus the
+    // deltas that were already applied when it started.
+    std::atomic<std::int64_t> base{0};
+    std::atomic<std::int64_t> delta{0};
+
+    std::int64_t Load() const;
+  };
+
+  void Reconcile();
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  userver::engine::SharedMutex reconcile_mutex_;
+  Counter teams_;
+  Counter users_;
+  Counter prs_;
+  userver::utils::PeriodicTask reconcile_task_;
+};
+
+}  // namespace prmanager::components
@@ -0,0 +1,175 @@
+#include "team_response_cache.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <mutex>
+
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/response.hpp"
+#include "../models/team.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+constexpr std::size_t kDefaultSize = 10000;
+constexpr std::size_t kDefaultWays = 16;
+constexpr std::chrono::seconds kDefaultLifetime{1};
+
+std::size_t GetWaySize(const userver::components::ComponentConfig& config) {
+  const auto size = config["size"].As<std::size_t>(kDefaultSize);
+  const auto ways = config["ways"].As<std::size_t>(kDefaultWays);
+  return (size + ways - 1) / ways;
+}
+
+}  // namespace
+
+TeamResponseCache::TeamResponseCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : ComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      metrics_(metrics::GetMetrics(context)),
+      cache_(config["ways"].As<std::size_t>(kDefaultWays),
+             GetWaySize(config)) {
+  cache_.SetMaxLifetime(config["lifetime"].As<std::chrono::milliseconds>(
+      kDefaultLifetime));
+  reset_registration_ = userver::testsuite::RegisterCache(
+      config, context, this, &TeamResponseCache::Clear);
+}
+
+userver::yaml_config::Schema TeamResponseCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::ComponentBase>(R"(
+type: object
+description: LRU cache of serialized /team/get responses
+additionalProperties: false
+properties:
+    size:
+        type: integer
+        description: maximum number of cached teams
+        defaultDescription: 10000
+        minimum: 1
+    ways:
+        type: integer
+        description: number of independently locked LRU shards
+        defaultDescription: 16
+        minimum: 1
+    lifetime:
+        type: string
+        description: how long a response is served without a database read
+        defaultDescription: 1s
+)");
+}
+
+TeamResponseCache::ResponsePtr TeamResponseCache::Get(
+    const std::string& team_name) {
+  if (auto cached = cache_.GetOptionalNoUpdate(team_name)) {
+    return std::move(*cached);
+  }
+
+  std::shared_ptr<Load> load;
+  {
+    std::lock_guard lock(mutex_);
+    auto& slot = loads_[team_name];
+    if (!slot) {
+      slot = std::make_shared<Load>(Load{userver::utils::SharedAsync(
+          "team-response-load",
+          [this, team_name] { return Fetch(team_name); })});
+    }
+    load = slot;
+  }
+
+  ResponsePtr response;
+  try {
+    response = load->task.Get();
+  } catch (const std::exception&) {
+    Finish(team_name, load, nullptr);
+    throw;
+  }
+  Finish(team_name, load, response);
+  return response;
+}
+
+void TeamResponseCache::Invalidate(const std::vector<std::string>& team_names) {
+  std::lock_guard lock(mutex_);
+  for (const auto& team_name : team_names) {
+    loads_.erase(team_name);
+    cache_.InvalidateByKey(team_name);
+  }
+}
+
+void TeamResponseCache::Clear() {
+  std::lock_guard lock(mutex_);
+  loads_.clear();
+  cache_.Invalidate();
+}
+
+TeamResponseCache::ResponsePtr TeamResponseCache::GetConsistent(
+    const std::string& team_name, const std::string& token) {
+  metrics::RequestScope scope{metrics_, "team_get_load"};
+  auto trx =
+      db::BeginConsistentRead(scope, *pg_cluster_, "team_get_load", token);
+  auto res = scope.Execute(trx, db::kSelectTeamMembers, team_name);
+  scope.Commit(trx);
+  return MakeResponse(team_name, res);
+}
+
+TeamResponseCache::ResponsePtr TeamResponseCache::Fetch(
+    const std::string& team_name) {
+  metrics::RequestScope scope{metrics_, "team_get_load"};
+  return MakeResponse(
+      team_name,
+      scope.Execute(*pg_cluster_,
+                    userver::storages::postgres::ClusterHostType::kSlave,
+                    db::kSelectTeamMembers, team_name));
+}
+
+TeamResponseCache::ResponsePtr TeamResponseCache::MakeResponse(
+    const std::string& team_name,
+    const userver::storages::postgres::ResultSet& res) {
+  auto response = std::make_shared<Response>();
+  if (res.IsEmpty()) {
+    response->body = models::ToJsonString(
+        models::ErrorResponse{"NOT_FOUND", "Team not found"});
+    return response;
+  }
+
+  models::Team team;
+  team.team_name = team_name;
+  for (const auto& row : res) {
+    if (row["id"].IsNull()) {
+      continue;
+    }
+    team.members.push_back(models::TeamMember{row["id"].As<std::string>(),
+                                              row["username"].As<std::string>(),
+                                              row["is_active"].As<bool>()});
+  }
+  response->found = true;
+  response->body = models::ToJsonString(team);
+  return response;
+}
+
+// The first waiter to finish retires the load; it is cached unless the
+// team was invalidated after the load had started, which unregistered it.
+void TeamResponseCache::Finish(const std::string& team_name,
+                               const std::shared_ptr<Load>& load,
+                               const ResponsePtr& response) {
+  std::lock_guard lock(mutex_);
+  const auto it = loads_.find(team_name);
+  if (it == loads_.end() || it->second != load) {
+    return;
+  }
+  loads_.erase(it);
+  if (response) {
+    cache_.Put(team_name, response);
+  }
+}
+
+}  // namespace prmanager::components
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/components/component_base.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/shared_task_with_result.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/testsuite/cache_control.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::components {
+
+// Serialized /team/get responses, "team not found" included. Concurrent
+// misses for the same team share one database round trip. Writes made by
+// this instance invalidate the teams they touch; writes made through other
+// instances show up once the entry expires.
+class TeamResponseCache final : public userver::components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "team-response-cache";
+
+  struct Response {
+    bool found{false};
+    std::string body;
+  };
+  using ResponsePtr = std::shared_ptr<const Response>;
+
+  TeamResponseCache(const userver::components::ComponentConfig& config,
+                    const userver::components::ComponentContext& context);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+  ResponsePtr Get(const std::string& team_name);
+
+  // Bypasses the cache and reads a state that includes the write behind the
+  // consistency token.
+  ResponsePtr GetConsistent(const std::string& team_name,
+                            const std::string& token);
+
+  // Call after the commit. Loads of these teams that started earlier are
+  // not cached; loads of other teams are not affected.
+  void Invalidate(const std::vector<std::string>& team_names);
+
+ private:
+  struct Load {
+    userver::engine::SharedTaskWithResult<ResponsePtr> task;
+  };
+
+  ResponsePtr Fetch(const std::string& team_name);
+  static ResponsePtr MakeResponse(
+      const std::string& team_name,
+      const userver::storages::postgres::ResultSet& res);
+  // Drops everything; testsuite calls it between tests.
+  void Clear();
+  void Finish(const std::string& team_name, const std::shared_ptr<Load>& load,
+              const ResponsePtr& response);
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  metrics::Metrics& metrics_;
+  userver::cache::ExpirableLruCache<std::string, ResponsePtr> cache_;
+
+  userver::engine::Mutex mutex_;
+  // Loads in flight. Invalidation unregisters the team's load, so a result
+  // read before the write is never stored.
+  std::unordered_map<std::string, std::shared_ptr<Load>> loads_;
+
+  userver::testsuite::CacheResetRegistration reset_registration_;
+};
+
+}  // namespace prmanager::components
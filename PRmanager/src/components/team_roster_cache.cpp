@@ -0,0 +1,100 @@
+#include "team_roster_cache.hpp"
+
+#include <userver/cache/update_type.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+
+#include <mutex>
+
+#include "../db/queries.hpp"
+
+namespace prmanager::components {
+
+namespace {
+
+// Rows are stamped with clock_timestamp() before commit, so a transaction
+// may become visible slightly after the previous update has started.
+constexpr std::chrono::seconds kUpdateCorrection{5};
+
+models::RosterMember ParseRosterMember(
+    const userver::storages::postgres::Row& row) {
+  return models::RosterMember{
+      row["id"].As<std::string>(), row["team_name"].As<std::string>(),
+      row["is_active"].As<bool>(),
+      row["updated_at"]
+          .As<userver::storages::postgres::TimePointTz>()
+          .GetUnderlying()};
+}
+
+}  // namespace
+
+TeamRosterCache::TeamRosterCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()) {
+  CacheUpdateTrait::StartPeriodicUpdates();
+}
+
+TeamRosterCache::~TeamRosterCache() {
+  CacheUpdateTrait::StopPeriodicUpdates();
+}
+
+void TeamRosterCache::ApplyCommitted(
+    const userver::storages::postgres::ResultSet& rows) {
+  if (rows.IsEmpty()) {
+    return;
+  }
+
+  std::lock_guard lock(set_mutex_);
+  auto roster = std::make_unique<models::TeamRoster>(*Get());
+  for (const auto& row : rows) {
+    roster->Upsert(ParseRosterMember(row));
+  }
+  Set(std::move(roster));
+}
+
+void TeamRosterCache::Update(
+    userver::cache::UpdateType type,
+    const std::chrono::system_clock::time_point& last_update,
+    const std::chrono::system_clock::time_point&,
+    userver::cache::UpdateStatisticsScope& stats_scope) {
+  const bool is_full = type == userver::cache::UpdateType::kFull;
+  auto res =
+      is_full
+          ? pg_cluster_->Execute(
+                userver::storages::postgres::ClusterHostType::kSlave,
+                db::kSelectRoster)
+          : pg_cluster_->Execute(
+                userver::storages::postgres::ClusterHostType::kSlave,
+                db::kSelectRosterSince,
+                userver::storages::postgres::TimePointTz{last_update -
+                                                         kUpdateCorrection});
+  stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+  if (!is_full && res.IsEmpty()) {
+    stats_scope.FinishNoChanges();
+    return;
+  }
+
+  std::lock_guard lock(set_mutex_);
+  auto roster = is_full ? std::make_unique<models::TeamRoster>()
+                        : std::make_unique<models::TeamRoster>(*Get());
+  bool changed = is_full;
+  for (const auto& row : res) {
+    changed |= roster->Upsert(ParseRosterMember(row));
+  }
+
+  if (!changed) {
+    stats_scope.FinishNoChanges();
+    return;
+  }
+
+  const auto size = roster->size();
+  Set(std::move(roster));
+  stats_scope.Finish(size);
+}
+
+}  // namespace prmanager::components
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "../models/team_roster.hpp"
+
+namespace prmanager::components {
+
+class TeamRosterCache final
+    : public userver::components::CachingComponentBase<models::TeamRoster> {
+ public:
+  static constexpr std::string_view kName = "team-roster-cache";
+
+  TeamRosterCache(const userver::components::ComponentConfig& config,
+                  const userver::components::ComponentContext& context);
+  ~TeamRosterCache() override;
+
+  // Applies users rows returned by a committed write, so the snapshot sees
+  // them before the next incremental update. Rows must contain id,
+  // team_name, is_active and updated_at.
+  void ApplyCommitted(const userver::storages::postgres::ResultSet& rows);
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  userver::engine::Mutex set_mutex_;
+};
+
+}  // namespace prmanager::components
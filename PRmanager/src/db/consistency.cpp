@@ -0,0 +1,85 @@
+#include "consistency.hpp"
+#include "queries.hpp"
+
+#include <userver/server/handlers/exceptions.hpp>
+
+#include <cctype>
+
+namespace prmanager::db {
+
+namespace {
+
+constexpr std::string_view kReadYourWrites = "read-your-writes";
+
+bool IsHexWord(std::string_view part) {
+  if (part.empty() || part.size() > 8) {
+    return false;
+  }
+  for (const char c : part) {
+    if (!std::isxdigit(static_cast<unsigned char>(c))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsLsn(std::string_view token) {
+  const auto separator = token.find('/');
+  return separator != std::string_view::npos &&
+         IsHexWord(token.substr(0, separator)) &&
+         IsHexWord(token.substr(separator + 1));
+}
+
+}  // namespace
+
+void SetConsistencyToken(const userver::server::http::HttpRequest& request,
+                         metrics::RequestScope& scope,
+                         userver::storages::postgres::Cluster& cluster) {
+  if (request.GetHeader(kConsistencyHeader) != kReadYourWrites) {
+    return;
+  }
+  auto res = scope.Execute(
+      cluster, userver::storages::postgres::ClusterHostType::kMaster,
+      kSelectCurrentLsn);
+  request.GetHttpResponse().SetHeader(std::string{kConsistencyTokenHeader},
+                                      res[0]["lsn"].As<std::string>());
+}
+
+std::optional<std::string> GetConsistencyToken(
+    const userver::server::http::HttpRequest& request) {
+  const auto& token = request.GetHeader(kConsistencyTokenHeader);
+  if (token.empty()) {
+    return std::nullopt;
+  }
+  if (!IsLsn(token)) {
+    throw userver::server::handlers::ClientError(
+        userver::server::handlers::ExternalBody{"Invalid consistency token"});
+  }
+  return token;
+}
+
+userver::storages::postgres::Transaction BeginConsistentRead(
+    metrics::RequestScope& scope,
+    userver::storages::postgres::Cluster& cluster, const std::string& name,
+    const std::string& token) {
+  // The check has to run inside the transaction: separate statements may be
+  // sent to different replicas.
+  auto trx = scope.Begin(cluster, name,
+                         userver::storages::postgres::ClusterHostType::kSlave,
+                         userver::storages::postgres::Transaction::RO);
+  try {
+    if (scope.Execute(trx, kSelectIsReplayed, token)[0]["replayed"]
+            .As<bool>()) {
+      return trx;
+    }
+    trx.Rollback();
+  } catch (const std::exception&) {
+    trx.Rollback();
+    throw;
+  }
+  return scope.Begin(cluster, name,
+                     userver::storages::postgres::ClusterHostType::kMaster,
+                     userver::storages::postgres::Transaction::RO);
+}
+
+}  // namespace prmanager::db
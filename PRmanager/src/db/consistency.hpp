@@ -0,0 +1,40 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/server/http/http_request.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+#include "../metrics/request_metrics.hpp"
+
+// Read-your-writes on top of replica reads. A write sent with
+// "X-Consistency: read-your-writes" gets the master WAL position after its
+// commit in the X-Consistency-Token response header. A read that passes the
+// token back in the same header is served by a replica that has replayed
+// that position, or by the master if the replica lags behind.
+namespace prmanager::db {
+
+inline constexpr std::string_view kConsistencyHeader = "X-Consistency";
+inline constexpr std::string_view kConsistencyTokenHeader =
+    "X-Consistency-Token";
+
+// Call after the commit. Costs one master round trip, only when the client
+// asked for a token.
+void SetConsistencyToken(const userver::server::http::HttpRequest& request,
+                         metrics::RequestScope& scope,
+                         userver::storages::postgres::Cluster& cluster);
+
+// Throws ClientError if the token is not a pg_lsn ("16/B374D848").
+std::optional<std::string> GetConsistencyToken(
+    const userver::server::http::HttpRequest& request);
+
+// Read-only transaction that sees every commit up to `token`.
+userver::storages::postgres::Transaction BeginConsistentRead(
+    metrics::RequestScope& scope,
+    userver::storages::postgres::Cluster& cluster, const std::string& name,
+    const std::string& token);
+
+}  // namespace prmanager::db
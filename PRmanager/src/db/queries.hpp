@@ -0,0 +1,437 @@
+#pragma once
+
+#include <userver/storages/postgres/query.hpp>
+
+// Every statement the service runs. Queries are named, so they are prepared
+// once per connection, get their own statement metrics and can be given
+// timeouts in POSTGRES_QUERIES_COMMAND_CONTROL under the same name.
+//
+// Parameters and results carry the external text ids. Joins go through the
+// integer keys (teams.id, users.uid, pull_requests.uid); a text id is
+// resolved to its key once per statement. Statuses are read as text.
+//
+// pull_requests and reviewers are partitioned by archived_month, see
+// 009_archive_partitions.sql. Open PRs are always in the 'infinity'
+// partitions, so statements about them say so and skip the archive;
+// reviewers are joined to their PR on (uid, archived_month).
+namespace prmanager::db {
+
+using Query = userver::storages::postgres::Query;
+
+// teams
+
+inline const Query kInsertTeam{
+    "INSERT INTO prmanager.teams (name) VALUES ($1) "
+    "ON CONFLICT (name) DO NOTHING",
+    Query::Name{"insert_team"}};
+
+inline const Query kInsertTeams{
+    "INSERT INTO prmanager.teams (name) SELECT UNNEST($1::text[]) "
+    "ON CONFLICT (name) DO NOTHING RETURNING name",
+    Query::Name{"insert_teams"}};
+
+// A team without members comes back as one row of NULLs.
+inline const Query kSelectTeamMembers{
+    "SELECT u.id, u.username, u.is_active FROM prmanager.teams t "
+    "LEFT JOIN prmanager.users u ON u.team_id = t.id "
+    "WHERE t.name = $1",
+    Query::Name{"select_team_members"}};
+
+// users
+
+// previous_team_name is read from the statement snapshot, i.e. before the
+// update, and is NULL for new users.
+// The teams in $3 must exist.
+inline const Query kUpsertUsers{
+    "INSERT INTO prmanager.users AS u (id, username, team_id, is_active) "
+    "SELECT i.id, i.username, t.id, i.is_active "
+    "FROM UNNEST($1::text[], $2::text[], $3::text[], $4::bool[]) "
+    "AS i(id, username, team_name, is_active) "
+    "JOIN prmanager.teams t ON t.name = i.team_name "
+    "ON CONFLICT (id) DO UPDATE SET username = EXCLUDED.username, "
+    "team_id = EXCLUDED.team_id, is_active = EXCLUDED.is_active "
+    "RETURNING u.id, "
+    "(SELECT t.name FROM prmanager.teams t WHERE t.id = u.team_id) "
+    "AS team_name, u.is_active, u.updated_at, (u.xmax = 0) AS inserted, "
+    "(SELECT t.name FROM prmanager.users p "
+    " JOIN prmanager.teams t ON t.id = p.team_id WHERE p.id = u.id) "
+    "AS previous_team_name",
+    Query::Name{"upsert_users"}};
+
+inline const Query kSetUserActive{
+    "UPDATE prmanager.users u SET is_active = $1 "
+    "FROM prmanager.teams t WHERE u.id = $2 AND t.id = u.team_id "
+    "RETURNING u.id, u.username, t.name AS team_name, u.is_active, "
+    "u.updated_at",
+    Query::Name{"set_user_active"}};
+
+inline const Query kDeactivateUsers{
+    "UPDATE prmanager.users u SET is_active = FALSE "
+    "FROM prmanager.teams t WHERE u.id = ANY($1) AND t.id = u.team_id "
+    "RETURNING u.id, u.uid, t.name AS team_name, u.is_active, u.updated_at",
+    Query::Name{"deactivate_users"}};
+
+inline const Query kSelectUserTeam{
+    "SELECT t.name AS team_name FROM prmanager.users u "
+    "JOIN prmanager.teams t ON t.id = u.team_id WHERE u.id = $1",
+    Query::Name{"select_user_team"}};
+
+// Reviewer candidates when the roster snapshot does not know the team yet.
+inline const Query kSelectActiveTeammates{
+    "SELECT u.id FROM prmanager.users u "
+    "WHERE u.team_id = (SELECT id FROM prmanager.teams WHERE name = $1) "
+    "AND u.is_active = TRUE AND NOT (u.id = ANY($2))",
+    Query::Name{"select_active_teammates"}};
+
+// Reviewer candidates of several authors at once, for batch creates.
+inline const Query kSelectActiveTeammatesOfAuthors{
+    "SELECT a.id AS author_id, u.id FROM prmanager.users a "
+    "JOIN prmanager.users u ON u.team_id = a.team_id "
+    "AND u.is_active = TRUE AND u.id <> a.id "
+    "WHERE a.id = ANY($1)",
+    Query::Name{"select_active_teammates_of_authors"}};
+
+inline const Query kSelectRoster{
+    "SELECT u.id, t.name AS team_name, u.is_active, u.updated_at "
+    "FROM prmanager.users u JOIN prmanager.teams t ON t.id = u.team_id",
+    Query::Name{"select_roster"}};
+
+inline const Query kSelectRosterSince{
+    "SELECT u.id, t.name AS team_name, u.is_active, u.updated_at "
+    "FROM prmanager.users u JOIN prmanager.teams t ON t.id = u.team_id "
+    "WHERE u.updated_at > $1",
+    Query::Name{"select_roster_since"}};
+
+inline const Query kSelectReviewLoads{
+    "SELECT u.id, t.name AS team_name, u.is_active, "
+    "COUNT(pr.uid) AS open_reviews "
+    "FROM prmanager.users u "
+    "JOIN prmanager.teams t ON t.id = u.team_id "
+    "LEFT JOIN prmanager.reviewers r "
+    "ON r.reviewer_uid = u.uid AND r.archived_month = 'infinity' "
+    "LEFT JOIN prmanager.pull_requests pr "
+    "ON pr.uid = r.pull_request_uid AND pr.archived_month = 'infinity' "
+    "AND pr.status = 'OPEN' "
+    "GROUP BY u.id, t.name",
+    Query::Name{"select_review_loads"}};
+
+// pull requests
+
+// $4 holds the reviewers picked by the service; they come back in the
+// same order. pr_exists reads the statement snapshot, so it is false for
+// the row inserted here and for a concurrent insert that hit ON CONFLICT.
+// Ids are unique through pull_request_keys, archived PRs included.
+inline const Query kInsertPullRequest{
+    "WITH author AS ("
+    "  SELECT id FROM prmanager.users WHERE id = $3"
+    "), new_key AS ("
+    "  INSERT INTO prmanager.pull_request_keys (id) "
+    "  SELECT $1 FROM author "
+    "  ON CONFLICT (id) DO NOTHING "
+    "  RETURNING id, uid"
+    "), new_pr AS ("
+    "  INSERT INTO prmanager.pull_requests (id, uid, name, author_id) "
+    "  SELECT id, uid, $2, $3 FROM new_key "
+    "  RETURNING uid"
+    "), picked AS ("
+    "  SELECT u.uid, u.id, p.n FROM UNNEST($4::text[]) WITH ORDINALITY "
+    "  AS p(id, n) JOIN prmanager.users u ON u.id = p.id"
+    "), new_reviewers AS ("
+    "  INSERT INTO prmanager.reviewers (pull_request_uid, reviewer_uid) "
+    "  SELECT new_pr.uid, picked.uid FROM new_pr, picked "
+    "  RETURNING reviewer_uid"
+    ") "
+    "SELECT EXISTS (SELECT 1 FROM new_pr) AS created, "
+    "EXISTS (SELECT 1 FROM prmanager.pull_request_keys WHERE id = $1) "
+    "AS pr_exists, "
+    "EXISTS (SELECT 1 FROM author) AS author_exists, "
+    "ARRAY(SELECT picked.id FROM new_reviewers nr "
+    "      JOIN picked ON picked.uid = nr.reviewer_uid "
+    "      ORDER BY picked.n) AS reviewers",
+    Query::Name{"insert_pull_request"}};
+
+// Batch form of kInsertPullRequest: $1..$3 are the PRs with distinct ids,
+// $4/$5 are (pull_request_id, reviewer_id) pairs. One row per input PR.
+inline const Query kInsertPullRequests{
+    "WITH input AS ("
+    "  SELECT * FROM UNNEST($1::text[], $2::text[], $3::text[]) "
+    "  AS i(id, name, author_id)"
+    "), new_keys AS ("
+    "  INSERT INTO prmanager.pull_request_keys (id) "
+    "  SELECT i.id FROM input i "
+    "  WHERE EXISTS (SELECT 1 FROM prmanager.users a WHERE a.id = i.author_id) "
+    "  ON CONFLICT (id) DO NOTHING "
+    "  RETURNING id, uid"
+    "), new_prs AS ("
+    "  INSERT INTO prmanager.pull_requests (id, uid, name, author_id) "
+    "  SELECT k.id, k.uid, i.name, i.author_id "
+    "  FROM new_keys k JOIN input i ON i.id = k.id "
+    "  RETURNING id, uid"
+    "), picked AS ("
+    "  SELECT new_prs.uid AS pull_request_uid, u.uid, u.id "
+    "  FROM UNNEST($4::text[], $5::text[]) AS r(pull_request_id, reviewer_id) "
+    "  JOIN new_prs ON new_prs.id = r.pull_request_id "
+    "  JOIN prmanager.users u ON u.id = r.reviewer_id"
+    "), new_reviewers AS ("
+    "  INSERT INTO prmanager.reviewers (pull_request_uid, reviewer_uid) "
+    "  SELECT pull_request_uid, uid FROM picked "
+    "  RETURNING pull_request_uid, reviewer_uid"
+    ") "
+    "SELECT i.id, new_prs.id IS NOT NULL AS created, "
+    "EXISTS (SELECT 1 FROM prmanager.pull_request_keys k WHERE k.id = i.id) "
+    "AS pr_exists, "
+    "EXISTS (SELECT 1 FROM prmanager.users u WHERE u.id = i.author_id) "
+    "AS author_exists, "
+    "ARRAY(SELECT picked.id FROM new_reviewers nr "
+    "      JOIN picked ON picked.pull_request_uid = nr.pull_request_uid "
+    "      AND picked.uid = nr.reviewer_uid "
+    "      WHERE nr.pull_request_uid = new_prs.uid) AS reviewers "
+    "FROM input i LEFT JOIN new_prs ON new_prs.id = i.id",
+    Query::Name{"insert_pull_requests"}};
+
+// Only an open PR is updated, and only in the hot partition. Otherwise the
+// PR is read as it is, locked so that a merge running concurrently is
+// waited for and its result returned; was_open is true only for the call
+// that actually merged the PR.
+inline const Query kMergePullRequest{
+    "WITH merged AS ("
+    "  UPDATE prmanager.pull_requests SET status = 'MERGED', "
+    "  merged_at = NOW() "
+    "  WHERE id = $1 AND archived_month = 'infinity' AND status = 'OPEN' "
+    "  RETURNING uid, id, name, author_id, status, merged_at, archived_month"
+    "), done AS ("
+    "  SELECT uid, id, name, author_id, status, merged_at, archived_month "
+    "  FROM prmanager.pull_requests "
+    "  WHERE id = $1 AND NOT EXISTS (SELECT 1 FROM merged) "
+    "  FOR SHARE"
+    ") "
+    "SELECT pr.id, pr.name, pr.author_id, pr.status::text AS status, "
+    "pr.merged_at, pr.was_open, ARRAY("
+    "  SELECT u.id FROM prmanager.reviewers r "
+    "  JOIN prmanager.users u ON u.uid = r.reviewer_uid "
+    "  WHERE r.pull_request_uid = pr.uid "
+    "  AND r.archived_month = pr.archived_month"
+    ") AS reviewers "
+    "FROM (SELECT *, TRUE AS was_open FROM merged "
+    "      UNION ALL SELECT *, FALSE FROM done) pr",
+    Query::Name{"merge_pull_request"}};
+
+// Batch form of kMergePullRequest. Open rows are locked in id order, so
+// overlapping batches do not deadlock; missing ids return no row.
+inline const Query kMergePullRequests{
+    "WITH locked AS ("
+    "  SELECT uid FROM prmanager.pull_requests "
+    "  WHERE id = ANY($1) AND archived_month = 'infinity' "
+    "  AND status = 'OPEN' "
+    "  ORDER BY id FOR UPDATE"
+    "), merged AS ("
+    "  UPDATE prmanager.pull_requests pr SET status = 'MERGED', "
+    "  merged_at = NOW() "
+    "  FROM locked WHERE pr.uid = locked.uid "
+    "  AND pr.archived_month = 'infinity' "
+    "  RETURNING pr.uid, pr.id, pr.name, pr.author_id, pr.status, "
+    "  pr.merged_at, pr.archived_month"
+    "), done AS ("
+    "  SELECT uid, id, name, author_id, status, merged_at, archived_month "
+    "  FROM prmanager.pull_requests "
+    "  WHERE id = ANY($1) AND uid NOT IN (SELECT uid FROM merged) "
+    "  FOR SHARE"
+    ") "
+    "SELECT pr.id, pr.name, pr.author_id, pr.status::text AS status, "
+    "pr.merged_at, pr.was_open, ARRAY("
+    "  SELECT u.id FROM prmanager.reviewers r "
+    "  JOIN prmanager.users u ON u.uid = r.reviewer_uid "
+    "  WHERE r.pull_request_uid = pr.uid "
+    "  AND r.archived_month = pr.archived_month"
+    ") AS reviewers "
+    "FROM (SELECT *, TRUE AS was_open FROM merged "
+    "      UNION ALL SELECT *, FALSE FROM done) pr",
+    Query::Name{"merge_pull_requests"}};
+
+// State of every PR for the stats aggregates; a full reload.
+inline const Query kSelectStatsPullRequests{
+    "SELECT pr.id, pr.status::text AS status, t.name AS team_name, "
+    "pr.created_at, pr.merged_at, ARRAY("
+    "  SELECT ru.id FROM prmanager.reviewers r "
+    "  JOIN prmanager.users ru ON ru.uid = r.reviewer_uid "
+    "  WHERE r.pull_request_uid = pr.uid "
+    "  AND r.archived_month = pr.archived_month"
+    ") AS reviewers "
+    "FROM prmanager.pull_requests pr "
+    "JOIN prmanager.users u ON u.id = pr.author_id "
+    "JOIN prmanager.teams t ON t.id = u.team_id",
+    Query::Name{"select_stats_pull_requests"}};
+
+// The same for the PRs named by events of the feed ($1 holds their ids).
+inline const Query kSelectStatsPullRequestsByIds{
+    "SELECT pr.id, pr.status::text AS status, t.name AS team_name, "
+    "pr.created_at, pr.merged_at, ARRAY("
+    "  SELECT ru.id FROM prmanager.reviewers r "
+    "  JOIN prmanager.users ru ON ru.uid = r.reviewer_uid "
+    "  WHERE r.pull_request_uid = pr.uid "
+    "  AND r.archived_month = pr.archived_month"
+    ") AS reviewers "
+    "FROM prmanager.pull_requests pr "
+    "JOIN prmanager.users u ON u.id = pr.author_id "
+    "JOIN prmanager.teams t ON t.id = u.team_id "
+    "WHERE pr.id = ANY($1)",
+    Query::Name{"select_stats_pull_requests_by_ids"}};
+
+inline const Query kCountRows{
+    "SELECT (SELECT COUNT(*) FROM prmanager.teams) AS teams, "
+    "(SELECT COUNT(*) FROM prmanager.users) AS users, "
+    "(SELECT COUNT(*) FROM prmanager.pull_requests) AS prs",
+    Query::Name{"count_rows"}};
+
+// reviewers
+
+// Always one row. The PR is locked first, in its own scan: the lock
+// serializes reassigns with each other and with merges and yields the
+// latest version of the row. Its reviewers are then locked against mass
+// deactivation, so they are the latest versions too. Only candidates read
+// the statement snapshot and may still name a reviewer swapped in
+// meanwhile. Archived PRs are merged and not locked: uid is NULL when the
+// PR is archived or, if pr_exists is false, missing.
+inline const Query kLockPullRequestForReassign{
+    "WITH pr AS MATERIALIZED ("
+    "  SELECT uid, name, status, author_id FROM prmanager.pull_requests "
+    "  WHERE id = $1 AND archived_month = 'infinity' "
+    "  FOR UPDATE"
+    ") "
+    "SELECT k.id IS NOT NULL AS pr_exists, pr.uid, pr.name, "
+    "pr.status::text AS status, pr.author_id, old.uid AS old_uid, "
+    "ARRAY(SELECT u.id FROM ("
+    "        SELECT r.reviewer_uid FROM prmanager.reviewers r "
+    "        WHERE r.pull_request_uid = pr.uid "
+    "        AND r.archived_month = 'infinity' "
+    "        ORDER BY r.reviewer_uid FOR UPDATE"
+    "      ) r JOIN prmanager.users u ON u.uid = r.reviewer_uid) "
+    "AS reviewers, "
+    "ARRAY(SELECT u.id FROM prmanager.users u "
+    "      WHERE u.team_id = old.team_id AND u.is_active = TRUE "
+    "      AND u.id <> pr.author_id AND NOT EXISTS ("
+    "        SELECT 1 FROM prmanager.reviewers r "
+    "        WHERE r.pull_request_uid = pr.uid AND r.reviewer_uid = u.uid "
+    "        AND r.archived_month = 'infinity')"
+    ") AS candidates "
+    "FROM (SELECT $1::text AS id) q "
+    "LEFT JOIN prmanager.pull_request_keys k ON k.id = q.id "
+    "LEFT JOIN pr ON TRUE "
+    "LEFT JOIN prmanager.users old ON old.id = $2",
+    Query::Name{"lock_pull_request_for_reassign"}};
+
+// Replaces reviewers in place: the review ($1[i], $2[i]) moves to the user
+// with the external id $3[i] and gets a fresh assigned_at. One row version
+// per swap instead of a deleted row plus an inserted one. Used by reassign
+// and mass deactivation.
+inline const Query kSwapReviewers{
+    "UPDATE prmanager.reviewers r "
+    "SET reviewer_uid = u.uid, assigned_at = NOW() "
+    "FROM UNNEST($1::bigint[], $2::bigint[], $3::text[]) "
+    "AS s(pull_request_uid, old_reviewer_uid, new_reviewer_id) "
+    "JOIN prmanager.users u ON u.id = s.new_reviewer_id "
+    "WHERE r.pull_request_uid = s.pull_request_uid "
+    "AND r.reviewer_uid = s.old_reviewer_uid "
+    "AND r.archived_month = 'infinity' "
+    "RETURNING r.pull_request_uid, s.old_reviewer_uid, r.reviewer_uid",
+    Query::Name{"swap_reviewers"}};
+
+// Open reviews of the given users ($1 holds users.uid), locked in a fixed
+// order until they are swapped or removed. current_reviewers includes the
+// locked reviewer.
+inline const Query kLockOpenReviews{
+    "SELECT r.pull_request_uid, r.reviewer_uid, u.id AS reviewer_id, "
+    "pr.author_id, ARRAY("
+    "  SELECT cu.id FROM prmanager.reviewers c "
+    "  JOIN prmanager.users cu ON cu.uid = c.reviewer_uid "
+    "  WHERE c.pull_request_uid = r.pull_request_uid "
+    "  AND c.archived_month = 'infinity'"
+    ") AS current_reviewers "
+    "FROM prmanager.reviewers r "
+    "JOIN prmanager.pull_requests pr ON pr.uid = r.pull_request_uid "
+    "AND pr.archived_month = r.archived_month "
+    "JOIN prmanager.users u ON u.uid = r.reviewer_uid "
+    "WHERE r.archived_month = 'infinity' AND pr.status = 'OPEN' "
+    "AND r.reviewer_uid = ANY($1) "
+    "ORDER BY r.pull_request_uid, r.reviewer_uid "
+    "FOR UPDATE OF r",
+    Query::Name{"lock_open_reviews"}};
+
+inline const Query kRemoveReviewers{
+    "DELETE FROM prmanager.reviewers r "
+    "USING UNNEST($1::bigint[], $2::bigint[]) "
+    "AS s(pull_request_uid, reviewer_uid) "
+    "WHERE r.pull_request_uid = s.pull_request_uid "
+    "AND r.reviewer_uid = s.reviewer_uid "
+    "AND r.archived_month = 'infinity'",
+    Query::Name{"remove_reviewers"}};
+
+// $2..$5 are NULL when the filter, the cursor or the limit is absent. The
+// cursor is (assigned_at, pull_requests.uid) of the last returned review.
+// Open PRs are never archived, so the OPEN filter reads the hot partitions
+// only.
+inline const Query kSelectReviews{
+    "SELECT pr.id, pr.name, pr.author_id, pr.status::text AS status, "
+    "r.assigned_at, r.pull_request_uid "
+    "FROM prmanager.reviewers r "
+    "JOIN prmanager.pull_requests pr ON pr.uid = r.pull_request_uid "
+    "AND pr.archived_month = r.archived_month "
+    "WHERE r.reviewer_uid = (SELECT uid FROM prmanager.users WHERE id = $1) "
+    "AND ($2::text IS NULL OR pr.status = $2::prmanager.pr_status) "
+    "AND r.archived_month >= CASE WHEN $2::text = 'OPEN' "
+    "THEN 'infinity'::date ELSE '-infinity'::date END "
+    "AND (r.assigned_at, r.pull_request_uid) > "
+    "(COALESCE($3, '-infinity'::timestamptz), COALESCE($4::bigint, 0)) "
+    "ORDER BY r.assigned_at, r.pull_request_uid "
+    "LIMIT $5",
+    Query::Name{"select_reviews"}};
+
+// archive, see pull_request_archiver.hpp
+
+// Months (UTC, as 'YYYY-MM-01') with merged PRs still in the hot
+// partitions that ended before the month of $1 started.
+inline const Query kSelectArchivableMonths{
+    "SELECT DISTINCT to_char(date_trunc('month', merged_at AT TIME ZONE "
+    "'UTC'), 'YYYY-MM-DD') AS month "
+    "FROM prmanager.pull_requests "
+    "WHERE archived_month = 'infinity' AND status = 'MERGED' "
+    "AND merged_at < date_trunc('month', $1::timestamptz AT TIME ZONE 'UTC') "
+    "AT TIME ZONE 'UTC' "
+    "ORDER BY month",
+    Query::Name{"select_archivable_months"}};
+
+inline const Query kArchiveMergedMonth{
+    "SELECT prmanager.archive_merged_month($1::date) AS moved",
+    Query::Name{"archive_merged_month"}};
+
+// change feed, see event_feed.hpp
+
+inline const Query kSelectLastEventSeq{
+    "SELECT COALESCE(MAX(seq), 0) AS seq FROM prmanager.events",
+    Query::Name{"select_last_event_seq"}};
+
+// Every row also carries the bounds of the snapshot it was read in: all
+// transactions below xmin have ended, all that started after it are at or
+// above xmax.
+inline const Query kSelectEvents{
+    "SELECT seq, type, pull_request_id, user_id, created_at, "
+    "pg_snapshot_xmin(s)::text::bigint AS snapshot_xmin, "
+    "pg_snapshot_xmax(s)::text::bigint AS snapshot_xmax "
+    "FROM prmanager.events, pg_current_snapshot() s "
+    "WHERE seq > $1 AND seq <= $2 "
+    "ORDER BY seq LIMIT $3",
+    Query::Name{"select_events"}};
+
+// consistency tokens, see consistency.hpp
+
+inline const Query kSelectCurrentLsn{
+    "SELECT pg_current_wal_lsn()::text AS lsn",
+    Query::Name{"select_current_lsn"}};
+
+// True on the master as well: kSlave falls back to it without replicas.
+inline const Query kSelectIsReplayed{
+    "SELECT NOT pg_is_in_recovery() OR "
+    "pg_last_wal_replay_lsn() >= $1::pg_lsn AS replayed",
+    Query::Name{"select_is_replayed"}};
+
+}  // namespace prmanager::db
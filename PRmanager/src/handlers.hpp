@@ -1,11 +1,16 @@
 #pragma once
 
+#include "handlers/events.hpp"
 #include "handlers/mass_deactivate.hpp"
 #include "handlers/pull_request_create.hpp"
+#include "handlers/pull_request_create_batch.hpp"
 #include "handlers/pull_request_merge.hpp"
+#include "handlers/pull_request_merge_batch.hpp"
 #include "handlers/pull_request_reassign.hpp"
 #include "handlers/stats.hpp"
+#include "handlers/stats_reviewers.hpp"
 #include "handlers/team_add.hpp"
+#include "handlers/team_add_batch.hpp"
 #include "handlers/team_get.hpp"
 #include "handlers/user_get_review.hpp"
 #include "handlers/user_set_is_active.hpp"
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "events.hpp"
+#include "../models/response.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+namespace prmanager::handlers {
+
+namespace {
+
+constexpr std::size_t kDefaultLimit = 100;
+constexpr std::size_t kMaxLimit = 1000;
+constexpr std::int64_t kDefaultTimeoutMs = 25000;
+constexpr std::int64_t kMaxTimeoutMs = 60000;
+
+[[noreturn]] void ThrowBadArg(const std::string& message) {
+  throw userver::server::handlers::ClientError(
+      userver::server::handlers::ExternalBody{message});
+}
+
+template <typename T>
+T GetNumericArg(const userver::server::http::HttpRequest& request,
+                const std::string& name, T default_value) {
+  if (!request.HasArg(name)) {
+    return default_value;
+  }
+  try {
+    return userver::utils::FromString<T>(request.GetArg(name));
+  } catch (const std::exception&) {
+    ThrowBadArg("Invalid " + name);
+  }
+}
+
+}  // namespace
+
+EventsHandler::EventsHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      feed_(context.FindComponent<components::EventFeed>()) {}
+
+std::string EventsHandler::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&) const {
+  if (!request.HasArg("since")) {
+    return models::ToJsonString(models::EventsResponse{{}, feed_.GetHead()});
+  }
+
+  const auto since = GetNumericArg<std::int64_t>(request, "since", 0);
+  const auto limit =
+      GetNumericArg<std::size_t>(request, "limit", kDefaultLimit);
+  const auto timeout_ms =
+      GetNumericArg<std::int64_t>(request, "timeout_ms", kDefaultTimeoutMs);
+  if (since < 0) {
+    ThrowBadArg("Invalid since");
+  }
+  if (limit == 0 || limit > kMaxLimit) {
+    ThrowBadArg("Invalid limit");
+  }
+  if (timeout_ms < 0 || timeout_ms > kMaxTimeoutMs) {
+    ThrowBadArg("Invalid timeout_ms");
+  }
+
+  auto page = feed_.Read(since, limit, std::chrono::milliseconds{timeout_ms});
+  return models::ToJsonString(
+      models::EventsResponse{std::move(page.events), page.next_since});
+}
+
+}  // namespace prmanager::handlers
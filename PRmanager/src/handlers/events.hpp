@@ -0,0 +1,26 @@
+#pragma once
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+#include "../components/event_feed.hpp"
+
+namespace prmanager::handlers {
+
+// Long-polling change feed: GET /events?since=<seq>[&limit=][&timeout_ms=].
+// Without `since` it answers right away with the current position.
+class EventsHandler final : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-events";
+
+  EventsHandler(const userver::components::ComponentConfig& config,
+                const userver::components::ComponentContext& context);
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext&) const override;
+
+ private:
+  components::EventFeed& feed_;
+};
+
+}  // namespace prmanager::handlers
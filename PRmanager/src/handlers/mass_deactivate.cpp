@@ -1,11 +1,17 @@
 #include "mass_deactivate.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/response.hpp"
 #include "../models/stats.hpp"
 #include "../models/user.hpp"
 
 #include <userver/components/component_context.hpp>
 #include <userver/formats/json.hpp>
 
-#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace prmanager::handlers {
 
@@ -15,89 +21,111 @@ MassDeactivateHandler::MassDeactivateHandler(
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      team_cache_(context.FindComponent<components::TeamResponseCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string MassDeactivateHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "mass_deactivate"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
   const auto req = body.As<models::MassDeactivateRequest>();
 
-  auto trx = pg_cluster_->Begin(
-      "mass_deactivate", userver::storages::postgres::ClusterHostType::kMaster,
-      {});
+  auto trx = scope.Begin(
+      *pg_cluster_, "mass_deactivate",
+      userver::storages::postgres::ClusterHostType::kMaster);
 
   try {
-    auto res_update = trx.Execute(
-        "UPDATE prmanager.users SET is_active = FALSE WHERE id = ANY($1) "
-        "RETURNING id",
-        req.user_ids);
+    auto res_update = scope.Execute(trx, db::kDeactivateUsers, req.user_ids);
 
+    std::vector<std::string> deactivated_ids;
+    std::vector<std::int64_t> deactivated_uids;
+    std::unordered_map<std::string, std::string> team_by_user;
+    deactivated_ids.reserve(res_update.Size());
+    deactivated_uids.reserve(res_update.Size());
     for (const auto& row_u : res_update) {
-      std::string user_id = row_u["id"].As<std::string>();
-
-      auto res_prs = trx.Execute(
-          "SELECT pr.id, pr.author_id, u.team_name "
-          "FROM prmanager.pull_requests pr "
-          "JOIN prmanager.reviewers r ON pr.id = r.pull_request_id "
-          "JOIN prmanager.users u ON u.id = $1 "
-          "WHERE r.reviewer_id = $1 AND pr.status = 'OPEN'",
-          user_id);
-
-      for (const auto& row_pr : res_prs) {
-        std::string pr_id = row_pr["id"].As<std::string>();
-        std::string author_id = row_pr["author_id"].As<std::string>();
-        std::string team_name = row_pr["team_name"].As<std::string>();
-
-        auto res_curr = trx.Execute(
-            "SELECT reviewer_id FROM prmanager.reviewers WHERE pull_request_id "
-            "= $1",
-            pr_id);
-        std::vector<std::string> current_reviewers;
-        for (const auto& r : res_curr) {
-          current_reviewers.push_back(r["reviewer_id"].As<std::string>());
-        }
-
-        auto res_cand = trx.Execute(
-            "SELECT id FROM prmanager.users "
-            "WHERE team_name = $1 AND is_active = TRUE AND id != $2 "
-            "AND NOT (id = ANY($3))",
-            team_name, author_id, current_reviewers);
-
-        if (!res_cand.IsEmpty()) {
-          std::vector<std::string> candidates;
-          for (const auto& r : res_cand) {
-            candidates.push_back(r["id"].As<std::string>());
-          }
-
-          std::string new_reviewer;
-          std::sample(candidates.begin(), candidates.end(), &new_reviewer, 1,
-                      std::mt19937{std::random_device{}()});
-
-          trx.Execute(
-              "DELETE FROM prmanager.reviewers WHERE pull_request_id = $1 AND "
-              "reviewer_id = $2",
-              pr_id, user_id);
-          trx.Execute(
-              "INSERT INTO prmanager.reviewers (pull_request_id, reviewer_id) "
-              "VALUES ($1, $2)",
-              pr_id, new_reviewer);
-        } else {
-          trx.Execute(
-              "DELETE FROM prmanager.reviewers WHERE pull_request_id = $1 AND "
-              "reviewer_id = $2",
-              pr_id, user_id);
-        }
+      auto user_id = row_u["id"].As<std::string>();
+      team_by_user.emplace(user_id, row_u["team_name"].As<std::string>());
+      deactivated_ids.push_back(std::move(user_id));
+      deactivated_uids.push_back(row_u["uid"].As<std::int64_t>());
+    }
+
+    auto res_reviews =
+        scope.Execute(trx, db::kLockOpenReviews, deactivated_uids);
+
+    // The assignment index still lists the users deactivated above as
+    // active until the roster picks up the commit.
+    const std::unordered_set<std::string> deactivated(deactivated_ids.begin(),
+                                                      deactivated_ids.end());
+
+    std::unordered_map<std::int64_t, std::vector<std::string>> excluded_by_pr;
+    std::vector<components::ReviewerAssignment::Reservation> reservations;
+    std::vector<std::string> removed_reviewer_ids;
+    std::vector<std::int64_t> swap_pr_uids, swap_old_uids;
+    std::vector<std::string> swap_new_ids;
+    std::vector<std::int64_t> drop_pr_uids, drop_reviewer_uids;
+    for (const auto& row : res_reviews) {
+      const auto pr_uid = row["pull_request_uid"].As<std::int64_t>();
+      const auto reviewer_uid = row["reviewer_uid"].As<std::int64_t>();
+      const auto reviewer_id = row["reviewer_id"].As<std::string>();
+      removed_reviewer_ids.push_back(reviewer_id);
+
+      auto [it, inserted] = excluded_by_pr.try_emplace(pr_uid);
+      auto& excluded = it->second;
+      if (inserted) {
+        excluded = row["current_reviewers"].As<std::vector<std::string>>();
+        excluded.push_back(row["author_id"].As<std::string>());
       }
+
+      auto& reservation = reservations.emplace_back(assignment_.Reserve(
+          team_by_user.at(reviewer_id), 1,
+          [&excluded, &deactivated](const std::string& user_id) {
+            return deactivated.count(user_id) > 0 ||
+                   std::find(excluded.begin(), excluded.end(), user_id) !=
+                       excluded.end();
+          }));
+      scope.AccountCandidates(reservation.GetPoolSize());
+      if (reservation.GetReviewers().empty()) {
+        drop_pr_uids.push_back(pr_uid);
+        drop_reviewer_uids.push_back(reviewer_uid);
+        continue;
+      }
+
+      const auto& new_reviewer = reservation.GetReviewers().front();
+      excluded.push_back(new_reviewer);
+      swap_pr_uids.push_back(pr_uid);
+      swap_old_uids.push_back(reviewer_uid);
+      swap_new_ids.push_back(new_reviewer);
     }
 
-    trx.Commit();
+    if (!swap_pr_uids.empty()) {
+      scope.Execute(trx, db::kSwapReviewers, swap_pr_uids, swap_old_uids,
+                    swap_new_ids);
+    }
+    if (!drop_pr_uids.empty()) {
+      scope.Execute(trx, db::kRemoveReviewers, drop_pr_uids,
+                    drop_reviewer_uids);
+    }
+
+    scope.Commit(trx);
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+    for (auto& reservation : reservations) {
+      reservation.Commit();
+    }
+    assignment_.Unassign(removed_reviewer_ids);
+    roster_cache_.ApplyCommitted(res_update);
+    std::unordered_set<std::string> changed_teams;
+    for (const auto& [user_id, team_name] : team_by_user) {
+      changed_teams.insert(team_name);
+    }
+    team_cache_.Invalidate({changed_teams.begin(), changed_teams.end()});
 
     models::MassDeactivateResponse response;
     response.deactivated_count = res_update.Size();
-    return userver::formats::json::ToString(models::Serialize(
-        response,
-        userver::formats::serialize::To<userver::formats::json::Value>{}));
+    return models::ToJsonString(response);
 
   } catch (const std::exception& e) {
     trx.Rollback();
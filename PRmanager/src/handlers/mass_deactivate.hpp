@@ -4,6 +4,11 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "../components/reviewer_assignment.hpp"
+#include "../components/team_response_cache.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
 namespace prmanager::handlers {
 
 class MassDeactivateHandler final
@@ -20,6 +25,10 @@ class MassDeactivateHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::TeamRosterCache& roster_cache_;
+  components::ReviewerAssignment& assignment_;
+  components::TeamResponseCache& team_cache_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
@@ -1,114 +1,120 @@
 #include "pull_request_create.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
 #include "../models/pull_request.hpp"
+#include "../models/response.hpp"
+#include "../utils/random.hpp"
 
 #include <userver/components/component_context.hpp>
 #include <userver/formats/json.hpp>
 
 #include <algorithm>
-#include <random>
+#include <iterator>
+#include <optional>
 
 namespace prmanager::handlers {
 
-namespace {
-
-userver::formats::json::Value BuildErrorResponse(const std::string& code,
-                                                 const std::string& message) {
-  userver::formats::json::ValueBuilder builder;
-  userver::formats::json::ValueBuilder error_builder;
-  error_builder["code"] = code;
-  error_builder["message"] = message;
-  builder["error"] = error_builder.ExtractValue();
-  return builder.ExtractValue();
-}
-
-}  // namespace
-
 PullRequestCreateHandler::PullRequestCreateHandler(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      stats_counters_(context.FindComponent<components::StatsCounters>()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      group_commit_(context.FindComponent<components::GroupCommit>()),
+      idempotency_(context.FindComponent<components::IdempotencyCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string PullRequestCreateHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  return idempotency_.Handle(request, [&] { return Create(request); });
+}
+
+std::string PullRequestCreateHandler::Create(
+    const userver::server::http::HttpRequest& request) const {
+  metrics::RequestScope scope{metrics_, "pr_create"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
   const auto pr_id = body["pull_request_id"].As<std::string>();
   const auto pr_name = body["pull_request_name"].As<std::string>();
   const auto author_id = body["author_id"].As<std::string>();
 
-  auto trx = pg_cluster_->Begin(
-      "pr_create", userver::storages::postgres::ClusterHostType::kMaster, {});
-
-  try {
-    auto res_pr = trx.Execute(
-        "SELECT 1 FROM prmanager.pull_requests WHERE id = $1", pr_id);
-    if (!res_pr.IsEmpty()) {
-      request.SetResponseStatus(userver::server::http::HttpStatus::kConflict);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("PR_EXISTS", "PR id already exists"));
-    }
-
-    auto res_author = trx.Execute(
-        "SELECT team_name FROM prmanager.users WHERE id = $1", author_id);
-    if (res_author.IsEmpty()) {
-      request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("NOT_FOUND", "Author not found"));
-    }
-    const auto team_name = res_author[0]["team_name"].As<std::string>();
-
-    auto res_candidates = trx.Execute(
-        "SELECT id FROM prmanager.users WHERE team_name = $1 AND is_active = "
-        "TRUE AND id != $2",
-        team_name, author_id);
-
-    std::vector<std::string> candidates;
-    for (const auto& row : res_candidates) {
-      candidates.push_back(row["id"].As<std::string>());
-    }
-
-    std::vector<std::string> reviewers;
-    if (candidates.size() <= 2) {
-      reviewers = candidates;
-    } else {
-      std::sample(candidates.begin(), candidates.end(),
-                  std::back_inserter(reviewers), 2,
-                  std::mt19937{std::random_device{}()});
+  // The least loaded teammates of the author are reserved up front. If the
+  // author is not in the roster yet, active teammates are read from the
+  // database and two of them are sampled.
+  std::vector<std::string> picked_reviewers;
+  std::optional<components::ReviewerAssignment::Reservation> reservation;
+  const auto roster = roster_cache_.Get();
+  if (const auto* author = roster->FindUser(author_id)) {
+    reservation.emplace(assignment_.Reserve(
+        author->team_name, 2,
+        [&author_id](const std::string& user_id) {
+          return user_id == author_id;
+        }));
+    scope.AccountCandidates(reservation->GetPoolSize());
+    picked_reviewers = reservation->GetReviewers();
+  } else {
+    auto res_author = scope.Execute(
+        *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+        db::kSelectUserTeam, author_id);
+    // A missing author is reported by the insert below.
+    if (!res_author.IsEmpty()) {
+      auto res_candidates = scope.Execute(
+          *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+          db::kSelectActiveTeammates,
+          res_author[0]["team_name"].As<std::string>(),
+          std::vector<std::string>{author_id});
+      std::vector<std::string> candidates;
+      for (const auto& row : res_candidates) {
+        candidates.push_back(row["id"].As<std::string>());
+      }
+      scope.AccountCandidates(candidates.size());
+      utils::WithRng([&](auto& rng) {
+        std::sample(candidates.begin(), candidates.end(),
+                    std::back_inserter(picked_reviewers), 2, rng);
+      });
     }
+  }
 
-    trx.Execute(
-        "INSERT INTO prmanager.pull_requests (id, name, author_id, status) "
-        "VALUES ($1, $2, $3, 'OPEN')",
-        pr_id, pr_name, author_id);
+  auto stats_guard = stats_counters_.BeginWrite();
+  auto res = scope.TimePostgres([&] {
+    return group_commit_.Execute(pr_id, db::kInsertPullRequest, pr_id, pr_name,
+                                 author_id, picked_reviewers);
+  });
 
-    for (const auto& reviewer : reviewers) {
-      trx.Execute(
-          "INSERT INTO prmanager.reviewers (pull_request_id, reviewer_id) "
-          "VALUES ($1, $2)",
-          pr_id, reviewer);
+  const auto& row = res[0];
+  if (!row["created"].As<bool>()) {
+    if (!row["pr_exists"].As<bool>() && !row["author_exists"].As<bool>()) {
+      request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
+      return models::ToJsonString(
+          models::ErrorResponse{"NOT_FOUND", "Author not found"});
     }
+    request.SetResponseStatus(userver::server::http::HttpStatus::kConflict);
+    return models::ToJsonString(
+        models::ErrorResponse{"PR_EXISTS", "PR id already exists"});
+  }
 
-    trx.Commit();
-
-    models::PullRequest pr;
-    pr.pull_request_id = pr_id;
-    pr.pull_request_name = pr_name;
-    pr.author_id = author_id;
-    pr.status = "OPEN";
-    pr.assigned_reviewers = reviewers;
-
-    request.SetResponseStatus(userver::server::http::HttpStatus::kCreated);
-    userver::formats::json::ValueBuilder response;
-    response["pr"] = pr;
-    return userver::formats::json::ToString(response.ExtractValue());
-
-  } catch (const std::exception& e) {
-    trx.Rollback();
-    throw;
+  stats_counters_.AddPullRequests(1);
+  stats_guard.unlock();
+  db::SetConsistencyToken(request, scope, *pg_cluster_);
+
+  models::PullRequest pr;
+  pr.pull_request_id = pr_id;
+  pr.pull_request_name = pr_name;
+  pr.author_id = author_id;
+  pr.status = "OPEN";
+  pr.assigned_reviewers = row["reviewers"].As<std::vector<std::string>>();
+  if (reservation) {
+    reservation->Commit();
+  } else {
+    assignment_.Assign(pr.assigned_reviewers);
   }
+
+  request.SetResponseStatus(userver::server::http::HttpStatus::kCreated);
+  return models::ToJsonString(models::PullRequestResponse{pr, {}});
 }
 
 }  // namespace prmanager::handlers
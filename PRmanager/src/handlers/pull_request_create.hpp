@@ -4,6 +4,13 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "../components/group_commit.hpp"
+#include "../components/idempotency_cache.hpp"
+#include "../components/reviewer_assignment.hpp"
+#include "../components/stats_counters.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
 namespace prmanager::handlers {
 
 class PullRequestCreateHandler final
@@ -20,7 +27,15 @@ class PullRequestCreateHandler final
       userver::server::request::RequestContext&) const override;
 
  private:
+  std::string Create(const userver::server::http::HttpRequest& request) const;
+
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  const components::TeamRosterCache& roster_cache_;
+  components::StatsCounters& stats_counters_;
+  components::ReviewerAssignment& assignment_;
+  components::GroupCommit& group_commit_;
+  components::IdempotencyCache& idempotency_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
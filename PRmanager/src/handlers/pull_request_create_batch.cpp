@@ -0,0 +1,168 @@
+#include "pull_request_create_batch.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/pull_request.hpp"
+#include "../models/response.hpp"
+#include "../utils/random.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace prmanager::handlers {
+
+PullRequestCreateBatchHandler::PullRequestCreateBatchHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      stats_counters_(context.FindComponent<components::StatsCounters>()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      metrics_(metrics::GetMetrics(context)) {}
+
+std::string PullRequestCreateBatchHandler::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "pr_create_batch"};
+  const auto body = userver::formats::json::FromString(request.RequestBody());
+  const auto req = body.As<models::PullRequestCreateBatchRequest>();
+  const auto size = req.pull_requests.size();
+
+  // An id repeated within the batch is reported as PR_EXISTS, as if the
+  // requests had been sent one by one.
+  std::vector<bool> is_repeated(size, false);
+  std::unordered_set<std::string> seen;
+  const auto roster = roster_cache_.Get();
+  std::vector<std::string> unknown_authors;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto& pr = req.pull_requests[i];
+    if (!seen.insert(pr.pull_request_id).second) {
+      is_repeated[i] = true;
+    } else if (!roster->FindUser(pr.author_id)) {
+      unknown_authors.push_back(pr.author_id);
+    }
+  }
+
+  // Authors missing from the roster snapshot get their candidates in one
+  // query for the whole batch.
+  std::unordered_map<std::string, std::vector<std::string>> candidates;
+  if (!unknown_authors.empty()) {
+    auto res_candidates = scope.Execute(
+        *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+        db::kSelectActiveTeammatesOfAuthors, unknown_authors);
+    for (const auto& row : res_candidates) {
+      candidates[row["author_id"].As<std::string>()].push_back(
+          row["id"].As<std::string>());
+    }
+  }
+
+  std::vector<std::optional<components::ReviewerAssignment::Reservation>>
+      reservations(size);
+  std::vector<std::string> ids, names, authors;
+  std::vector<std::string> reviewer_pr_ids, reviewer_ids;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (is_repeated[i]) {
+      continue;
+    }
+    const auto& pr = req.pull_requests[i];
+    std::vector<std::string> picked_reviewers;
+    if (const auto* author = roster->FindUser(pr.author_id)) {
+      auto& reservation = reservations[i].emplace(assignment_.Reserve(
+          author->team_name, 2, [&pr](const std::string& user_id) {
+            return user_id == pr.author_id;
+          }));
+      scope.AccountCandidates(reservation.GetPoolSize());
+      picked_reviewers = reservation.GetReviewers();
+    } else if (const auto it = candidates.find(pr.author_id);
+               it != candidates.end()) {
+      scope.AccountCandidates(it->second.size());
+      utils::WithRng([&](auto& rng) {
+        std::sample(it->second.begin(), it->second.end(),
+                    std::back_inserter(picked_reviewers), 2, rng);
+      });
+    }
+
+    ids.push_back(pr.pull_request_id);
+    names.push_back(pr.pull_request_name);
+    authors.push_back(pr.author_id);
+    for (auto& reviewer_id : picked_reviewers) {
+      reviewer_pr_ids.push_back(pr.pull_request_id);
+      reviewer_ids.push_back(std::move(reviewer_id));
+    }
+  }
+
+  auto trx = scope.Begin(
+      *pg_cluster_, "pr_create_batch",
+      userver::storages::postgres::ClusterHostType::kMaster);
+
+  try {
+    auto res = scope.Execute(trx, db::kInsertPullRequests, ids, names,
+                             authors, reviewer_pr_ids, reviewer_ids);
+    std::int64_t created = 0;
+    for (const auto& row : res) {
+      created += row["created"].As<bool>() ? 1 : 0;
+    }
+
+    auto stats_guard = stats_counters_.BeginWrite();
+    scope.Commit(trx);
+    stats_counters_.AddPullRequests(created);
+    stats_guard.unlock();
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+
+    std::unordered_map<std::string, std::size_t> row_by_id;
+    for (std::size_t row = 0; row < res.Size(); ++row) {
+      row_by_id.emplace(res[row]["id"].As<std::string>(), row);
+    }
+
+    models::PullRequestBatchResponse response;
+    response.results.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto& item = req.pull_requests[i];
+      auto& result = response.results.emplace_back();
+      if (is_repeated[i]) {
+        result.error =
+            models::ErrorResponse{"PR_EXISTS", "PR id already exists"};
+        continue;
+      }
+
+      const auto row = res[row_by_id.at(item.pull_request_id)];
+      if (!row["created"].As<bool>()) {
+        if (!row["pr_exists"].As<bool>() && !row["author_exists"].As<bool>()) {
+          result.error = models::ErrorResponse{"NOT_FOUND", "Author not found"};
+        } else {
+          result.error =
+              models::ErrorResponse{"PR_EXISTS", "PR id already exists"};
+        }
+        continue;
+      }
+
+      auto& pr = result.pr.emplace();
+      pr.pull_request_id = item.pull_request_id;
+      pr.pull_request_name = item.pull_request_name;
+      pr.author_id = item.author_id;
+      pr.status = "OPEN";
+      pr.assigned_reviewers = row["reviewers"].As<std::vector<std::string>>();
+      if (reservations[i]) {
+        reservations[i]->Commit();
+      } else {
+        assignment_.Assign(pr.assigned_reviewers);
+      }
+    }
+
+    return models::ToJsonString(response);
+
+  } catch (const std::exception& e) {
+    trx.Rollback();
+    throw;
+  }
+}
+
+}  // namespace prmanager::handlers
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "../components/reviewer_assignment.hpp"
+#include "../components/stats_counters.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::handlers {
+
+class PullRequestCreateBatchHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-pr-create-batch";
+
+  PullRequestCreateBatchHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& context);
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext&) const override;
+
+ private:
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const components::TeamRosterCache& roster_cache_;
+  components::StatsCounters& stats_counters_;
+  components::ReviewerAssignment& assignment_;
+  metrics::Metrics& metrics_;
+};
+
+}  // namespace prmanager::handlers
@@ -1,5 +1,8 @@
 #include "pull_request_merge.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
 #include "../models/pull_request.hpp"
+#include "../models/response.hpp"
 
 #include <userver/components/component_context.hpp>
 #include <userver/formats/json.hpp>
@@ -8,81 +11,56 @@
 
 namespace prmanager::handlers {
 
-namespace {
-
-userver::formats::json::Value BuildErrorResponse(const std::string& code,
-                                                 const std::string& message) {
-  userver::formats::json::ValueBuilder builder;
-  userver::formats::json::ValueBuilder error_builder;
-  error_builder["code"] = code;
-  error_builder["message"] = message;
-  builder["error"] = error_builder.ExtractValue();
-  return builder.ExtractValue();
-}
-
-}  // namespace
-
 PullRequestMergeHandler::PullRequestMergeHandler(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      group_commit_(context.FindComponent<components::GroupCommit>()),
+      idempotency_(context.FindComponent<components::IdempotencyCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string PullRequestMergeHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  return idempotency_.Handle(request, [&] { return Merge(request); });
+}
+
+std::string PullRequestMergeHandler::Merge(
+    const userver::server::http::HttpRequest& request) const {
+  metrics::RequestScope scope{metrics_, "pr_merge"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
   const auto pr_id = body["pull_request_id"].As<std::string>();
 
-  auto trx = pg_cluster_->Begin(
-      "pr_merge", userver::storages::postgres::ClusterHostType::kMaster, {});
-
-  try {
-    auto res_pr = trx.Execute(
-        "UPDATE prmanager.pull_requests SET status = 'MERGED', merged_at = "
-        "COALESCE(merged_at, NOW()) "
-        "WHERE id = $1 RETURNING id, name, author_id, status, merged_at",
-        pr_id);
-
-    if (res_pr.IsEmpty()) {
-      request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("NOT_FOUND", "PR not found"));
-    }
-
-    auto res_reviewers = trx.Execute(
-        "SELECT reviewer_id FROM prmanager.reviewers WHERE pull_request_id = "
-        "$1",
-        pr_id);
-    std::vector<std::string> reviewers;
-    for (const auto& row : res_reviewers) {
-      reviewers.push_back(row["reviewer_id"].As<std::string>());
-    }
-
-    trx.Commit();
-
-    const auto& row = res_pr[0];
-    models::PullRequest pr;
-    pr.pull_request_id = row["id"].As<std::string>();
-    pr.pull_request_name = row["name"].As<std::string>();
-    pr.author_id = row["author_id"].As<std::string>();
-    pr.status = row["status"].As<std::string>();
-    pr.assigned_reviewers = reviewers;
-    pr.merged_at = userver::utils::datetime::Timestring(
-        row["merged_at"]
-            .As<userver::storages::postgres::TimePointTz>()
-            .GetUnderlying());
-
-    userver::formats::json::ValueBuilder response;
-    response["pr"] = pr;
-    return userver::formats::json::ToString(response.ExtractValue());
+  auto res_pr = scope.TimePostgres([&] {
+    return group_commit_.Execute(pr_id, db::kMergePullRequest, pr_id);
+  });
+  if (res_pr.IsEmpty()) {
+    request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
+    return models::ToJsonString(
+        models::ErrorResponse{"NOT_FOUND", "PR not found"});
+  }
 
-  } catch (const std::exception& e) {
-    trx.Rollback();
-    throw;
+  db::SetConsistencyToken(request, scope, *pg_cluster_);
+  const auto& row = res_pr[0];
+  models::PullRequest pr;
+  pr.pull_request_id = row["id"].As<std::string>();
+  pr.pull_request_name = row["name"].As<std::string>();
+  pr.author_id = row["author_id"].As<std::string>();
+  pr.status = row["status"].As<std::string>();
+  pr.assigned_reviewers = row["reviewers"].As<std::vector<std::string>>();
+  pr.merged_at = userver::utils::datetime::Timestring(
+      row["merged_at"]
+          .As<userver::storages::postgres::TimePointTz>()
+          .GetUnderlying());
+  if (row["was_open"].As<bool>()) {
+    assignment_.Unassign(pr.assigned_reviewers);
   }
+
+  return models::ToJsonString(models::PullRequestResponse{pr, {}});
 }
 
 }  // namespace prmanager::handlers
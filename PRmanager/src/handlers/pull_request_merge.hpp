@@ -4,6 +4,11 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "../components/group_commit.hpp"
+#include "../components/idempotency_cache.hpp"
+#include "../components/reviewer_assignment.hpp"
+#include "../metrics/request_metrics.hpp"
+
 namespace prmanager::handlers {
 
 class PullRequestMergeHandler final
@@ -19,7 +24,13 @@ class PullRequestMergeHandler final
       userver::server::request::RequestContext&) const override;
 
  private:
+  std::string Merge(const userver::server::http::HttpRequest& request) const;
+
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::ReviewerAssignment& assignment_;
+  components::GroupCommit& group_commit_;
+  components::IdempotencyCache& idempotency_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
@@ -0,0 +1,80 @@
+#include "pull_request_merge_batch.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/pull_request.hpp"
+#include "../models/response.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include <unordered_map>
+
+namespace prmanager::handlers {
+
+PullRequestMergeBatchHandler::PullRequestMergeBatchHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      metrics_(metrics::GetMetrics(context)) {}
+
+std::string PullRequestMergeBatchHandler::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "pr_merge_batch"};
+  const auto body = userver::formats::json::FromString(request.RequestBody());
+  const auto req = body.As<models::PullRequestMergeBatchRequest>();
+
+  auto trx = scope.Begin(
+      *pg_cluster_, "pr_merge_batch",
+      userver::storages::postgres::ClusterHostType::kMaster);
+
+  try {
+    auto res = scope.Execute(trx, db::kMergePullRequests, req.pull_request_ids);
+    scope.Commit(trx);
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+
+    // A repeated id gets the same PR; merge is idempotent anyway.
+    std::unordered_map<std::string, models::PullRequest> merged;
+    for (const auto& row : res) {
+      models::PullRequest pr;
+      pr.pull_request_id = row["id"].As<std::string>();
+      pr.pull_request_name = row["name"].As<std::string>();
+      pr.author_id = row["author_id"].As<std::string>();
+      pr.status = row["status"].As<std::string>();
+      pr.assigned_reviewers = row["reviewers"].As<std::vector<std::string>>();
+      pr.merged_at = userver::utils::datetime::Timestring(
+          row["merged_at"]
+              .As<userver::storages::postgres::TimePointTz>()
+              .GetUnderlying());
+      if (row["was_open"].As<bool>()) {
+        assignment_.Unassign(pr.assigned_reviewers);
+      }
+      merged.emplace(pr.pull_request_id, std::move(pr));
+    }
+
+    models::PullRequestBatchResponse response;
+    response.results.reserve(req.pull_request_ids.size());
+    for (const auto& pr_id : req.pull_request_ids) {
+      auto& result = response.results.emplace_back();
+      if (const auto it = merged.find(pr_id); it != merged.end()) {
+        result.pr = it->second;
+      } else {
+        result.error = models::ErrorResponse{"NOT_FOUND", "PR not found"};
+      }
+    }
+
+    return models::ToJsonString(response);
+
+  } catch (const std::exception& e) {
+    trx.Rollback();
+    throw;
+  }
+}
+
+}  // namespace prmanager::handlers
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+
+#include "../components/reviewer_assignment.hpp"
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::handlers {
+
+class PullRequestMergeBatchHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-pr-merge-batch";
+
+  PullRequestMergeBatchHandler(
+      const userver::components::ComponentConfig& config,
+      const userver::components::ComponentContext& context);
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext&) const override;
+
+ private:
+  userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::ReviewerAssignment& assignment_;
+  metrics::Metrics& metrics_;
+};
+
+}  // namespace prmanager::handlers
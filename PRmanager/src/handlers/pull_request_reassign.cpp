@@ -1,148 +1,133 @@
 #include "pull_request_reassign.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
 #include "../models/pull_request.hpp"
+#include "../models/response.hpp"
+#include "../utils/random.hpp"
 
 #include <userver/components/component_context.hpp>
 #include <userver/formats/json.hpp>
 
 #include <algorithm>
-#include <random>
+#include <cstdint>
+#include <optional>
 
 namespace prmanager::handlers {
 
-namespace {
-
-userver::formats::json::Value BuildErrorResponse(const std::string& code,
-                                                 const std::string& message) {
-  userver::formats::json::ValueBuilder builder;
-  userver::formats::json::ValueBuilder error_builder;
-  error_builder["code"] = code;
-  error_builder["message"] = message;
-  builder["error"] = error_builder.ExtractValue();
-  return builder.ExtractValue();
-}
-
-}  // namespace
-
 PullRequestReassignHandler::PullRequestReassignHandler(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      assignment_(context.FindComponent<components::ReviewerAssignment>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string PullRequestReassignHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "pr_reassign"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
   const auto pr_id = body["pull_request_id"].As<std::string>();
   const auto old_user_id = body["old_user_id"].As<std::string>();
 
-  auto trx = pg_cluster_->Begin(
-      "pr_reassign", userver::storages::postgres::ClusterHostType::kMaster, {});
+  auto trx = scope.Begin(
+      *pg_cluster_, "pr_reassign",
+      userver::storages::postgres::ClusterHostType::kMaster);
 
   try {
-    auto res_pr = trx.Execute(
-        "SELECT status, author_id FROM prmanager.pull_requests WHERE id = $1",
-        pr_id);
-    if (res_pr.IsEmpty()) {
+    const auto res_pr = scope.Execute(trx, db::kLockPullRequestForReassign,
+                                      pr_id, old_user_id);
+    const auto& row = res_pr[0];
+    if (!row["pr_exists"].As<bool>()) {
       request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("NOT_FOUND", "PR not found"));
+      return models::ToJsonString(
+          models::ErrorResponse{"NOT_FOUND", "PR not found"});
     }
-    if (res_pr[0]["status"].As<std::string>() == "MERGED") {
+    // The lock reads the hot partitions only, an archived PR is merged.
+    if (row["uid"].IsNull() || row["status"].As<std::string>() == "MERGED") {
       request.SetResponseStatus(userver::server::http::HttpStatus::kConflict);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("PR_MERGED", "cannot reassign on merged PR"));
+      return models::ToJsonString(
+          models::ErrorResponse{"PR_MERGED", "cannot reassign on merged PR"});
     }
-    const auto author_id = res_pr[0]["author_id"].As<std::string>();
-
-    auto res_reviewer = trx.Execute(
-        "SELECT 1 FROM prmanager.reviewers WHERE pull_request_id = $1 AND "
-        "reviewer_id = $2",
-        pr_id, old_user_id);
-    if (res_reviewer.IsEmpty()) {
+    auto current_reviewers = row["reviewers"].As<std::vector<std::string>>();
+    if (std::find(current_reviewers.begin(), current_reviewers.end(),
+                  old_user_id) == current_reviewers.end()) {
       request.SetResponseStatus(userver::server::http::HttpStatus::kConflict);
-      return userver::formats::json::ToString(BuildErrorResponse(
-          "NOT_ASSIGNED", "reviewer is not assigned to this PR"));
-    }
-
-    auto res_user = trx.Execute(
-        "SELECT team_name FROM prmanager.users WHERE id = $1", old_user_id);
-    if (res_user.IsEmpty()) {
-      request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("NOT_FOUND", "User not found"));
-    }
-    const auto team_name = res_user[0]["team_name"].As<std::string>();
-
-    auto res_current_reviewers = trx.Execute(
-        "SELECT reviewer_id FROM prmanager.reviewers WHERE pull_request_id = "
-        "$1",
-        pr_id);
-    std::vector<std::string> current_reviewers;
-    for (const auto& row : res_current_reviewers) {
-      current_reviewers.push_back(row["reviewer_id"].As<std::string>());
+      return models::ToJsonString(models::ErrorResponse{
+          "NOT_ASSIGNED", "reviewer is not assigned to this PR"});
     }
 
-    auto res_candidates = trx.Execute(
-        "SELECT id FROM prmanager.users WHERE team_name = $1 AND is_active = "
-        "TRUE AND id != $2",
-        team_name, author_id);
-
-    std::vector<std::string> candidates;
-    for (const auto& row : res_candidates) {
-      std::string uid = row["id"].As<std::string>();
-      bool is_reviewer = false;
-      for (const auto& r : current_reviewers) {
-        if (r == uid) {
-          is_reviewer = true;
-          break;
-        }
-      }
-      if (!is_reviewer) {
-        candidates.push_back(uid);
+    // Active teammates of the old reviewer that are neither the author nor
+    // reviewers already. The least loaded one is picked in memory; if the
+    // load index does not know them yet, a random one. The candidates come
+    // from the snapshot, the reviewers from the lock: drop anyone swapped in
+    // by a reassign or deactivation the lock waited for.
+    auto candidates = row["candidates"].As<std::vector<std::string>>();
+    candidates.erase(
+        std::remove_if(candidates.begin(), candidates.end(),
+                       [&current_reviewers](const std::string& user_id) {
+                         return std::find(current_reviewers.begin(),
+                                          current_reviewers.end(),
+                                          user_id) != current_reviewers.end();
+                       }),
+        candidates.end());
+    scope.AccountCandidates(candidates.size());
+    std::string new_reviewer_id;
+    std::optional<components::ReviewerAssignment::Reservation> reservation;
+    if (const auto* old_user = roster_cache_.Get()->FindUser(old_user_id)) {
+      reservation.emplace(assignment_.Reserve(
+          old_user->team_name, 1, [&candidates](const std::string& user_id) {
+            return std::find(candidates.begin(), candidates.end(),
+                             user_id) == candidates.end();
+          }));
+      if (!reservation->GetReviewers().empty()) {
+        new_reviewer_id = reservation->GetReviewers().front();
       }
     }
+    if (new_reviewer_id.empty()) {
+      utils::WithRng([&](auto& rng) {
+        std::sample(candidates.begin(), candidates.end(), &new_reviewer_id, 1,
+                    rng);
+      });
+      reservation.reset();
+    }
 
-    if (candidates.empty()) {
+    if (new_reviewer_id.empty()) {
       request.SetResponseStatus(userver::server::http::HttpStatus::kConflict);
-      return userver::formats::json::ToString(BuildErrorResponse(
-          "NO_CANDIDATE", "no active replacement candidate in team"));
+      return models::ToJsonString(models::ErrorResponse{
+          "NO_CANDIDATE", "no active replacement candidate in team"});
     }
 
-    std::string new_reviewer_id;
-    std::sample(candidates.begin(), candidates.end(), &new_reviewer_id, 1,
-                std::mt19937{std::random_device{}()});
-
-    trx.Execute(
-        "DELETE FROM prmanager.reviewers WHERE pull_request_id = $1 AND "
-        "reviewer_id = $2",
-        pr_id, old_user_id);
-    trx.Execute(
-        "INSERT INTO prmanager.reviewers (pull_request_id, reviewer_id) VALUES "
-        "($1, $2)",
-        pr_id, new_reviewer_id);
-
-    trx.Commit();
+    scope.Execute(
+        trx, db::kSwapReviewers,
+        std::vector<std::int64_t>{row["uid"].As<std::int64_t>()},
+        std::vector<std::int64_t>{row["old_uid"].As<std::int64_t>()},
+        std::vector<std::string>{new_reviewer_id});
+
+    scope.Commit(trx);
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+    if (reservation) {
+      reservation->Commit();
+    } else {
+      assignment_.Assign({new_reviewer_id});
+    }
+    assignment_.Unassign({old_user_id});
 
     std::replace(current_reviewers.begin(), current_reviewers.end(),
                  old_user_id, new_reviewer_id);
 
     models::PullRequest pr;
     pr.pull_request_id = pr_id;
-    auto res_pr_details = pg_cluster_->Execute(
-        userver::storages::postgres::ClusterHostType::kSlave,
-        "SELECT name FROM prmanager.pull_requests WHERE id = $1", pr_id);
-    pr.pull_request_name = res_pr_details[0]["name"].As<std::string>();
-    pr.author_id = author_id;
+    pr.pull_request_name = row["name"].As<std::string>();
+    pr.author_id = row["author_id"].As<std::string>();
     pr.status = "OPEN";
     pr.assigned_reviewers = current_reviewers;
 
-    userver::formats::json::ValueBuilder response;
-    response["pr"] = pr;
-    response["replaced_by"] = new_reviewer_id;
-    return userver::formats::json::ToString(response.ExtractValue());
+    return models::ToJsonString(
+        models::PullRequestResponse{pr, new_reviewer_id});
 
   } catch (const std::exception& e) {
     trx.Rollback();
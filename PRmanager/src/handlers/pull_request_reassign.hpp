@@ -4,6 +4,10 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "../components/reviewer_assignment.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
 namespace prmanager::handlers {
 
 class PullRequestReassignHandler final
@@ -21,6 +25,9 @@ class PullRequestReassignHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  const components::TeamRosterCache& roster_cache_;
+  components::ReviewerAssignment& assignment_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
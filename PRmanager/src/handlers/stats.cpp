@@ -1,4 +1,5 @@
 #include "stats.hpp"
+#include "../models/response.hpp"
 #include "../models/stats.hpp"
 
 #include <userver/components/component_context.hpp>
@@ -9,31 +10,25 @@ namespace prmanager::handlers {
 StatsHandler::StatsHandler(const userver::components::ComponentConfig& config,
                            const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
-      pg_cluster_(
-          context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+      stats_counters_(context.FindComponent<components::StatsCounters>()),
+      stats_aggregates_(
+          context.FindComponent<components::StatsAggregatesCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string StatsHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest&,
     userver::server::request::RequestContext&) const {
-  auto res_teams =
-      pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
-                           "SELECT COUNT(*) FROM prmanager.teams");
-  auto res_users =
-      pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
-                           "SELECT COUNT(*) FROM prmanager.users");
-  auto res_prs =
-      pg_cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
-                           "SELECT COUNT(*) FROM prmanager.pull_requests");
+  metrics::RequestScope scope{metrics_, "stats"};
+  auto response = stats_counters_.GetStats();
 
-  models::StatsResponse response;
-  response.teams_count = res_teams[0][0].As<int>();
-  response.users_count = res_users[0][0].As<int>();
-  response.prs_count = res_prs[0][0].As<int>();
+  const auto aggregates = stats_aggregates_.Get();
+  response.open_prs_count = aggregates->GetOpenCount();
+  response.merged_prs_count = aggregates->GetMergedCount();
+  response.mean_time_to_merge_seconds =
+      aggregates->GetMeanTimeToMergeSeconds();
+  response.teams_load = aggregates->GetTeamsLoad();
 
-  return userver::formats::json::ToString(models::Serialize(
-      response,
-      userver::formats::serialize::To<userver::formats::json::Value>{}));
+  return models::ToJsonString(response);
 }
 
 }  // namespace prmanager::handlers
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <userver/server/handlers/http_handler_base.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
+
+#include "../components/stats_aggregates_cache.hpp"
+#include "../components/stats_counters.hpp"
+#include "../metrics/request_metrics.hpp"
 
 namespace prmanager::handlers {
 
@@ -18,7 +20,9 @@ class StatsHandler final : public userver::server::handlers::HttpHandlerBase {
       userver::server::request::RequestContext&) const override;
 
  private:
-  userver::storages::postgres::ClusterPtr pg_cluster_;
+  const components::StatsCounters& stats_counters_;
+  const components::StatsAggregatesCache& stats_aggregates_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
@@ -0,0 +1,54 @@
+#include "stats_reviewers.hpp"
+#include "../models/response.hpp"
+#include "../models/stats.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json.hpp>
+#include <userver/utils/from_string.hpp>
+
+namespace prmanager::handlers {
+
+namespace {
+
+constexpr std::size_t kDefaultLimit = 100;
+constexpr std::size_t kMaxLimit = 1000;
+
+}  // namespace
+
+StatsReviewersHandler::StatsReviewersHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      stats_aggregates_(
+          context.FindComponent<components::StatsAggregatesCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
+
+std::string StatsReviewersHandler::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "stats_reviewers"};
+  std::size_t limit = kDefaultLimit;
+  if (request.HasArg("limit")) {
+    try {
+      limit = userver::utils::FromString<std::size_t>(request.GetArg("limit"));
+    } catch (const std::exception&) {
+      throw userver::server::handlers::ClientError(
+          userver::server::handlers::ExternalBody{"Invalid limit"});
+    }
+    if (limit == 0 || limit > kMaxLimit) {
+      throw userver::server::handlers::ClientError(
+          userver::server::handlers::ExternalBody{"Invalid limit"});
+    }
+  }
+  const auto& cursor = request.GetArg("cursor");
+
+  models::ReviewerStatsResponse response;
+  response.reviewers = stats_aggregates_.Get()->GetReviewers(cursor, limit);
+  if (response.reviewers.size() == limit) {
+    response.next_cursor = response.reviewers.back().user_id;
+  }
+
+  return models::ToJsonString(response);
+}
+
+}  // namespace prmanager::handlers
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+#include "../components/stats_aggregates_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
+namespace prmanager::handlers {
+
+class StatsReviewersHandler final
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-stats-reviewers";
+
+  StatsReviewersHandler(const userver::components::ComponentConfig& config,
+                        const userver::components::ComponentContext& context);
+
+  std::string HandleRequestThrow(
+      const userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext&) const override;
+
+ private:
+  const components::StatsAggregatesCache& stats_aggregates_;
+  metrics::Metrics& metrics_;
+};
+
+}  // namespace prmanager::handlers
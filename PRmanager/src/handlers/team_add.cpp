@@ -1,24 +1,71 @@
 #include "team_add.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/response.hpp"
 #include "../models/team.hpp"
 
 #include <userver/components/component_context.hpp>
 #include <userver/formats/json.hpp>
 
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace prmanager::handlers {
 
-namespace {
+userver::storages::postgres::ResultSet UpsertTeamMembers(
+    userver::storages::postgres::Transaction& trx,
+    const std::vector<models::Team>& teams) {
+  std::vector<std::string> ids;
+  std::vector<std::string> usernames;
+  std::vector<std::string> team_names;
+  std::vector<bool> is_active;
+  std::unordered_map<std::string_view, std::size_t> index_by_id;
+
+  for (const auto& team : teams) {
+    for (const auto& member : team.members) {
+      const auto [it, inserted] =
+          index_by_id.emplace(member.user_id, ids.size());
+      if (!inserted) {
+        // ON CONFLICT cannot touch the same row twice in one statement.
+        usernames[it->second] = member.username;
+        team_names[it->second] = team.team_name;
+        is_active[it->second] = member.is_active;
+        continue;
+      }
+      ids.push_back(member.user_id);
+      usernames.push_back(member.username);
+      team_names.push_back(team.team_name);
+      is_active.push_back(member.is_active);
+    }
+  }
 
-userver::formats::json::Value BuildErrorResponse(const std::string& code,
-                                                 const std::string& message) {
-  userver::formats::json::ValueBuilder builder;
-  userver::formats::json::ValueBuilder error_builder;
-  error_builder["code"] = code;
-  error_builder["message"] = message;
-  builder["error"] = error_builder.ExtractValue();
-  return builder.ExtractValue();
+  return trx.Execute(db::kUpsertUsers, ids, usernames, team_names, is_active);
 }
 
-}  // namespace
+std::vector<std::string> CollectChangedTeams(
+    const std::vector<models::Team>& teams,
+    const userver::storages::postgres::ResultSet& upserted) {
+  std::unordered_set<std::string> changed;
+  for (const auto& team : teams) {
+    changed.insert(team.team_name);
+  }
+  for (const auto& row : upserted) {
+    if (!row["previous_team_name"].IsNull()) {
+      changed.insert(row["previous_team_name"].As<std::string>());
+    }
+  }
+  return {changed.begin(), changed.end()};
+}
+
+std::int64_t CountInsertedMembers(
+    const userver::storages::postgres::ResultSet& upserted) {
+  std::int64_t count = 0;
+  for (const auto& row : upserted) {
+    count += row["inserted"].As<bool>() ? 1 : 0;
+  }
+  return count;
+}
 
 TeamAddHandler::TeamAddHandler(
     const userver::components::ComponentConfig& config,
@@ -26,48 +73,50 @@ TeamAddHandler::TeamAddHandler(
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      stats_counters_(context.FindComponent<components::StatsCounters>()),
+      team_cache_(context.FindComponent<components::TeamResponseCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string TeamAddHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "team_add"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
-  const auto team = body.As<models::Team>();
+  const std::vector<models::Team> teams{body.As<models::Team>()};
+  const auto& team = teams.front();
 
-  auto trx = pg_cluster_->Begin(
-      "team_add", userver::storages::postgres::ClusterHostType::kMaster, {});
+  auto trx = scope.Begin(
+      *pg_cluster_, "team_add",
+      userver::storages::postgres::ClusterHostType::kMaster);
 
   try {
-    auto res = trx.Execute("SELECT 1 FROM prmanager.teams WHERE name = $1",
-                           team.team_name);
-    if (!res.IsEmpty()) {
+    auto res = scope.Execute(trx, db::kInsertTeam, team.team_name);
+    if (res.RowsAffected() == 0) {
       request.SetResponseStatus(userver::server::http::HttpStatus::kBadRequest);
-      return userver::formats::json::ToString(
-          BuildErrorResponse("TEAM_EXISTS", "team_name already exists"));
+      return models::ToJsonString(
+          models::ErrorResponse{"TEAM_EXISTS", "team_name already exists"});
     }
 
-    trx.Execute("INSERT INTO prmanager.teams (name) VALUES ($1)",
-                team.team_name);
-
-    for (const auto& member : team.members) {
-      trx.Execute(
-          "INSERT INTO prmanager.users (id, username, team_name, is_active) "
-          "VALUES ($1, $2, $3, $4) "
-          "ON CONFLICT (id) DO UPDATE SET username = $2, team_name = $3, "
-          "is_active = $4",
-          member.user_id, member.username, team.team_name, member.is_active);
-    }
+    auto res_members = scope.TimePostgres(
+        [&] { return UpsertTeamMembers(trx, teams); });
 
-    trx.Commit();
+    auto stats_guard = stats_counters_.BeginWrite();
+    scope.Commit(trx);
+    stats_counters_.AddTeams(1);
+    stats_counters_.AddUsers(CountInsertedMembers(res_members));
+    stats_guard.unlock();
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+    roster_cache_.ApplyCommitted(res_members);
+    team_cache_.Invalidate(CollectChangedTeams(teams, res_members));
   } catch (const std::exception& e) {
     trx.Rollback();
     throw;
   }
 
   request.SetResponseStatus(userver::server::http::HttpStatus::kCreated);
-  userver::formats::json::ValueBuilder response;
-  response["team"] = team;
-  return userver::formats::json::ToString(response.ExtractValue());
+  return models::ToJsonString(models::TeamResponse{team});
 }
 
 }  // namespace prmanager::handlers
@@ -1,11 +1,38 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+#include "../components/stats_counters.hpp"
+#include "../components/team_response_cache.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+#include "../models/team.hpp"
 
 namespace prmanager::handlers {
 
+// Upserts members of all teams with one array-parameter statement. If a user
+// is listed several times, the last entry wins. Returns the rows expected by
+// TeamRosterCache::ApplyCommitted plus an `inserted` flag and the
+// `previous_team_name` (NULL for new users) per row.
+userver::storages::postgres::ResultSet UpsertTeamMembers(
+    userver::storages::postgres::Transaction& trx,
+    const std::vector<models::Team>& teams);
+
+std::int64_t CountInsertedMembers(
+    const userver::storages::postgres::ResultSet& upserted);
+
+// Names of the added teams plus the teams that upserted members moved from.
+std::vector<std::string> CollectChangedTeams(
+    const std::vector<models::Team>& teams,
+    const userver::storages::postgres::ResultSet& upserted);
+
 class TeamAddHandler final : public userver::server::handlers::HttpHandlerBase {
  public:
   static constexpr std::string_view kName = "handler-team-add";
@@ -19,6 +46,10 @@ class TeamAddHandler final : public userver::server::handlers::HttpHandlerBase {
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::TeamRosterCache& roster_cache_;
+  components::StatsCounters& stats_counters_;
+  components::TeamResponseCache& team_cache_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
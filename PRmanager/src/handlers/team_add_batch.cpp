@@ -0,0 +1,94 @@
+#include "team_add_batch.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/response.hpp"
+#include "../models/team.hpp"
+#include "team_add.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json.hpp>
+
+#include <unordered_set>
+
+namespace prmanager::handlers {
+
+TeamAddBatchHandler::TeamAddBatchHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : HttpHandlerBase(config, context),
+      pg_cluster_(
+          context.FindComponent<userver::components::Postgres>("postgres-db-1")
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      stats_counters_(context.FindComponent<components::StatsCounters>()),
+      team_cache_(context.FindComponent<components::TeamResponseCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
+
+std::string TeamAddBatchHandler::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "team_add_batch"};
+  const auto body = userver::formats::json::FromString(request.RequestBody());
+  const auto req = body.As<models::TeamAddBatchRequest>();
+
+  std::vector<std::string> team_names;
+  team_names.reserve(req.teams.size());
+  for (const auto& team : req.teams) {
+    team_names.push_back(team.team_name);
+  }
+
+  // Teams that already exist (or repeat within the batch) are reported as
+  // TEAM_EXISTS and their members are left untouched, as in /team/add.
+  std::vector<models::Team> created;
+  std::vector<bool> is_created(req.teams.size(), false);
+
+  auto trx = scope.Begin(
+      *pg_cluster_, "team_add_batch",
+      userver::storages::postgres::ClusterHostType::kMaster);
+
+  try {
+    auto res_teams = scope.Execute(trx, db::kInsertTeams, team_names);
+
+    std::unordered_set<std::string> inserted;
+    for (const auto& row : res_teams) {
+      inserted.insert(row["name"].As<std::string>());
+    }
+    for (std::size_t i = 0; i < req.teams.size(); ++i) {
+      if (inserted.erase(req.teams[i].team_name) > 0) {
+        is_created[i] = true;
+        created.push_back(req.teams[i]);
+      }
+    }
+
+    auto res_members = scope.TimePostgres(
+        [&] { return UpsertTeamMembers(trx, created); });
+
+    auto stats_guard = stats_counters_.BeginWrite();
+    scope.Commit(trx);
+    stats_counters_.AddTeams(static_cast<std::int64_t>(created.size()));
+    stats_counters_.AddUsers(CountInsertedMembers(res_members));
+    stats_guard.unlock();
+    db::SetConsistencyToken(request, scope, *pg_cluster_);
+    roster_cache_.ApplyCommitted(res_members);
+    team_cache_.Invalidate(CollectChangedTeams(created, res_members));
+  } catch (const std::exception& e) {
+    trx.Rollback();
+    throw;
+  }
+
+  models::TeamAddBatchResponse response;
+  response.results.reserve(req.teams.size());
+  for (std::size_t i = 0; i < req.teams.size(); ++i) {
+    auto& result = response.results.emplace_back();
+    if (is_created[i]) {
+      result.team = req.teams[i];
+    } else {
+      result.error =
+          models::ErrorResponse{"TEAM_EXISTS", "team_name already exists"};
+    }
+  }
+
+  return models::ToJsonString(response);
+}
+
+}  // namespace prmanager::handlers
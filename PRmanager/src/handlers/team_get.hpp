@@ -1,8 +1,9 @@
 #pragma once
 
 #include <userver/server/handlers/http_handler_base.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
+
+#include "../components/team_response_cache.hpp"
+#include "../metrics/request_metrics.hpp"
 
 namespace prmanager::handlers {
 
@@ -18,7 +19,8 @@ class TeamGetHandler final : public userver::server::handlers::HttpHandlerBase {
       userver::server::request::RequestContext&) const override;
 
  private:
-  userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::TeamResponseCache& team_cache_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
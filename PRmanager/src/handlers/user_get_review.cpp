@@ -1,47 +1,239 @@
 #include "user_get_review.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
 #include "../models/pull_request.hpp"
+#include "../models/response.hpp"
 
 #include <userver/components/component_context.hpp>
+#include <userver/crypto/base64.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/formats/json.hpp>
+#include <userver/storages/postgres/portal.hpp>
+#include <userver/utils/from_string.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 
 namespace prmanager::handlers {
 
+namespace {
+
+constexpr std::size_t kMaxLimit = 1000;
+constexpr std::uint32_t kStreamChunkRows = 500;
+
+models::PullRequestShort ParsePullRequestShort(
+    const userver::storages::postgres::Row& row) {
+  return models::PullRequestShort{
+      row["id"].As<std::string>(), row["name"].As<std::string>(),
+      row["author_id"].As<std::string>(), row["status"].As<std::string>()};
+}
+
+// The cursor is the position of the last returned review:
+// "<assigned_at in microseconds>:<pull_requests.uid>", base64url encoded.
+std::string EncodeCursor(const userver::storages::postgres::TimePointTz& at,
+                         std::int64_t pr_uid) {
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          at.GetUnderlying().time_since_epoch())
+                          .count();
+  return userver::crypto::base64::Base64UrlEncode(
+      std::to_string(micros) + ':' + std::to_string(pr_uid),
+      userver::crypto::base64::Pad::kWithout);
+}
+
+[[noreturn]] void ThrowBadArg(const std::string& message) {
+  throw userver::server::handlers::ClientError(
+      userver::server::handlers::ExternalBody{message});
+}
+
+}  // namespace
+
 UserGetReviewHandler::UserGetReviewHandler(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string UserGetReviewHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
-  const auto& user_id = request.GetArg("user_id");
-  if (user_id.empty()) {
-    throw userver::server::handlers::ClientError(
-        userver::server::handlers::ExternalBody{"Missing user_id"});
-  }
-
-  auto res = pg_cluster_->Execute(
-      userver::storages::postgres::ClusterHostType::kSlave,
-      "SELECT pr.id, pr.name, pr.author_id, pr.status "
-      "FROM prmanager.pull_requests pr "
-      "JOIN prmanager.reviewers r ON pr.id = r.pull_request_id "
-      "WHERE r.reviewer_id = $1",
-      user_id);
-
-  std::vector<models::PullRequestShort> prs;
-  for (const auto& row : res) {
-    prs.push_back(models::PullRequestShort{
-        row["id"].As<std::string>(), row["name"].As<std::string>(),
-        row["author_id"].As<std::string>(), row["status"].As<std::string>()});
-  }
-
-  userver::formats::json::ValueBuilder response;
-  response["user_id"] = user_id;
-  response["pull_requests"] = prs;
-  return userver::formats::json::ToString(response.ExtractValue());
+  metrics::RequestScope scope{metrics_, "user_get_review"};
+  return GetPage(ParseQuery(request), scope);
+}
+
+void UserGetReviewHandler::HandleStreamRequest(
+    userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&,
+    userver::server::http::ResponseBodyStream& response_body_stream) const {
+  metrics::RequestScope scope{metrics_, "user_get_review"};
+  ReviewQuery query;
+  try {
+    query = ParseQuery(request);
+  } catch (const userver::server::handlers::ClientError& e) {
+    response_body_stream.SetStatusCode(
+        userver::server::http::HttpStatus::kBadRequest);
+    response_body_stream.SetEndOfHeaders();
+    response_body_stream.PushBodyChunk(std::string{e.GetExternalErrorBody()},
+                                       userver::engine::Deadline{});
+    return;
+  }
+
+  if (query.limit || query.after_pull_request_uid) {
+    auto page = GetPage(query, scope);
+    response_body_stream.SetStatusCode(userver::server::http::HttpStatus::kOk);
+    response_body_stream.SetEndOfHeaders();
+    response_body_stream.PushBodyChunk(std::move(page),
+                                       userver::engine::Deadline{});
+    return;
+  }
+
+  StreamAll(query, scope, response_body_stream);
+}
+
+UserGetReviewHandler::ReviewQuery UserGetReviewHandler::ParseQuery(
+    const userver::server::http::HttpRequest& request) {
+  ReviewQuery query;
+  query.user_id = request.GetArg("user_id");
+  if (query.user_id.empty()) {
+    ThrowBadArg("Missing user_id");
+  }
+
+  if (request.HasArg("status")) {
+    const auto& status = request.GetArg("status");
+    if (status != "OPEN" && status != "MERGED") {
+      ThrowBadArg("Invalid status");
+    }
+    query.status = status;
+  }
+
+  if (request.HasArg("limit")) {
+    try {
+      query.limit =
+          userver::utils::FromString<std::size_t>(request.GetArg("limit"));
+    } catch (const std::exception&) {
+      ThrowBadArg("Invalid limit");
+    }
+    if (*query.limit == 0 || *query.limit > kMaxLimit) {
+      ThrowBadArg("Invalid limit");
+    }
+  }
+
+  if (request.HasArg("cursor")) {
+    try {
+      const auto decoded = userver::crypto::base64::Base64UrlDecode(
+          request.GetArg("cursor"));
+      const auto separator = decoded.find(':');
+      if (separator == std::string::npos) {
+        ThrowBadArg("Invalid cursor");
+      }
+      const auto micros = userver::utils::FromString<std::int64_t>(
+          decoded.substr(0, separator));
+      query.after_assigned_at = userver::storages::postgres::TimePointTz{
+          std::chrono::system_clock::time_point{
+              std::chrono::duration_cast<
+                  std::chrono::system_clock::duration>(
+                  std::chrono::microseconds{micros})}};
+      query.after_pull_request_uid = userver::utils::FromString<std::int64_t>(
+          decoded.substr(separator + 1));
+    } catch (const userver::server::handlers::ClientError&) {
+      throw;
+    } catch (const std::exception&) {
+      ThrowBadArg("Invalid cursor");
+    }
+    if (!query.limit) {
+      query.limit = kMaxLimit;
+    }
+  }
+
+  query.consistency_token = db::GetConsistencyToken(request);
+  return query;
+}
+
+std::string UserGetReviewHandler::GetPage(const ReviewQuery& query,
+                                          metrics::RequestScope& scope) const {
+  // One extra row tells whether there is a next page.
+  std::optional<std::int64_t> fetch_limit;
+  if (query.limit) {
+    fetch_limit = static_cast<std::int64_t>(*query.limit) + 1;
+  }
+
+  const auto res = [&] {
+    if (!query.consistency_token) {
+      return scope.Execute(
+          *pg_cluster_, userver::storages::postgres::ClusterHostType::kSlave,
+          db::kSelectReviews, query.user_id, query.status,
+          query.after_assigned_at, query.after_pull_request_uid, fetch_limit);
+    }
+    auto trx = db::BeginConsistentRead(scope, *pg_cluster_, "user_get_review",
+                                       *query.consistency_token);
+    auto page = scope.Execute(trx, db::kSelectReviews, query.user_id,
+                              query.status, query.after_assigned_at,
+                              query.after_pull_request_uid, fetch_limit);
+    scope.Commit(trx);
+    return page;
+  }();
+
+  const auto count = query.limit ? std::min(res.Size(), *query.limit)
+                                 : res.Size();
+  models::ReviewsResponse response;
+  response.user_id = query.user_id;
+  response.pull_requests.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    response.pull_requests.push_back(ParsePullRequestShort(res[i]));
+  }
+  if (count < res.Size()) {
+    const auto& last = res[count - 1];
+    response.next_cursor = EncodeCursor(
+        last["assigned_at"].As<userver::storages::postgres::TimePointTz>(),
+        last["pull_request_uid"].As<std::int64_t>());
+  }
+  return models::ToJsonString(response);
+}
+
+void UserGetReviewHandler::StreamAll(
+    const ReviewQuery& query, metrics::RequestScope& scope,
+    userver::server::http::ResponseBodyStream& response_body_stream) const {
+  auto trx = query.consistency_token
+                 ? db::BeginConsistentRead(scope, *pg_cluster_,
+                                           "user_get_review",
+                                           *query.consistency_token)
+                 : scope.Begin(
+                       *pg_cluster_, "user_get_review",
+                       userver::storages::postgres::ClusterHostType::kSlave,
+                       userver::storages::postgres::Transaction::RO);
+  auto portal = trx.MakePortal(
+      db::kSelectReviews, query.user_id, query.status, query.after_assigned_at,
+      query.after_pull_request_uid, std::optional<std::int64_t>{});
+
+  response_body_stream.SetStatusCode(userver::server::http::HttpStatus::kOk);
+  response_body_stream.SetEndOfHeaders();
+  userver::formats::json::StringBuilder user_id_sw;
+  user_id_sw.WriteString(query.user_id);
+  response_body_stream.PushBodyChunk(
+      "{\"user_id\":" + user_id_sw.GetString() + ",\"pull_requests\":[",
+      userver::engine::Deadline{});
+
+  bool first = true;
+  while (portal) {
+    auto res =
+        scope.TimePostgres([&] { return portal.Fetch(kStreamChunkRows); });
+    std::string chunk;
+    for (const auto& row : res) {
+      if (!first) chunk += ',';
+      first = false;
+      chunk += models::ToJsonString(ParsePullRequestShort(row));
+    }
+    if (!chunk.empty()) {
+      response_body_stream.PushBodyChunk(std::move(chunk),
+                                         userver::engine::Deadline{});
+    }
+  }
+  scope.Commit(trx);
+
+  response_body_stream.PushBodyChunk("]}", userver::engine::Deadline{});
 }
 
 }  // namespace prmanager::handlers
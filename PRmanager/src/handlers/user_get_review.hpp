@@ -1,11 +1,23 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
 #include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+
+#include "../metrics/request_metrics.hpp"
 
 namespace prmanager::handlers {
 
+// Reviews are ordered by assigned_at, then by the internal PR key. Requests
+// with `limit` or `cursor` get one page; other requests are streamed in
+// chunks when `response-body-stream` is enabled for the handler.
 class UserGetReviewHandler final
     : public userver::server::handlers::HttpHandlerBase {
  public:
@@ -18,8 +30,34 @@ class UserGetReviewHandler final
       const userver::server::http::HttpRequest& request,
       userver::server::request::RequestContext&) const override;
 
+  void HandleStreamRequest(
+      userver::server::http::HttpRequest& request,
+      userver::server::request::RequestContext&,
+      userver::server::http::ResponseBodyStream& response_body_stream)
+      const override;
+
  private:
+  struct ReviewQuery {
+    std::string user_id;
+    std::optional<std::string> status;
+    std::optional<std::size_t> limit;
+    std::optional<userver::storages::postgres::TimePointTz> after_assigned_at;
+    std::optional<std::int64_t> after_pull_request_uid;
+    std::optional<std::string> consistency_token;
+  };
+
+  static ReviewQuery ParseQuery(
+      const userver::server::http::HttpRequest& request);
+
+  std::string GetPage(const ReviewQuery& query,
+                      metrics::RequestScope& scope) const;
+
+  void StreamAll(
+      const ReviewQuery& query, metrics::RequestScope& scope,
+      userver::server::http::ResponseBodyStream& response_body_stream) const;
+
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
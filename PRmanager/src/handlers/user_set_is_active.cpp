@@ -1,4 +1,7 @@
 #include "user_set_is_active.hpp"
+#include "../db/consistency.hpp"
+#include "../db/queries.hpp"
+#include "../models/response.hpp"
 #include "../models/user.hpp"
 
 #include <userver/components/component_context.hpp>
@@ -6,55 +9,45 @@
 
 namespace prmanager::handlers {
 
-namespace {
-
-userver::formats::json::Value BuildErrorResponse(const std::string& code,
-                                                 const std::string& message) {
-  userver::formats::json::ValueBuilder builder;
-  userver::formats::json::ValueBuilder error_builder;
-  error_builder["code"] = code;
-  error_builder["message"] = message;
-  builder["error"] = error_builder.ExtractValue();
-  return builder.ExtractValue();
-}
-
-}  // namespace
-
 UserSetIsActiveHandler::UserSetIsActiveHandler(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& context)
     : HttpHandlerBase(config, context),
       pg_cluster_(
           context.FindComponent<userver::components::Postgres>("postgres-db-1")
-              .GetCluster()) {}
+              .GetCluster()),
+      roster_cache_(context.FindComponent<components::TeamRosterCache>()),
+      team_cache_(context.FindComponent<components::TeamResponseCache>()),
+      metrics_(metrics::GetMetrics(context)) {}
 
 std::string UserSetIsActiveHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&) const {
+  metrics::RequestScope scope{metrics_, "user_set_is_active"};
   const auto body = userver::formats::json::FromString(request.RequestBody());
   const auto user_id = body["user_id"].As<std::string>();
   const auto is_active = body["is_active"].As<bool>();
 
-  auto res = pg_cluster_->Execute(
-      userver::storages::postgres::ClusterHostType::kMaster,
-      "UPDATE prmanager.users SET is_active = $1 WHERE id = $2 "
-      "RETURNING id, username, team_name, is_active",
-      is_active, user_id);
+  auto res = scope.Execute(
+      *pg_cluster_, userver::storages::postgres::ClusterHostType::kMaster,
+      db::kSetUserActive, is_active, user_id);
 
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-    return userver::formats::json::ToString(
-        BuildErrorResponse("NOT_FOUND", "User not found"));
+    return models::ToJsonString(
+        models::ErrorResponse{"NOT_FOUND", "User not found"});
   }
 
+  roster_cache_.ApplyCommitted(res);
+  db::SetConsistencyToken(request, scope, *pg_cluster_);
+
   const auto& row = res[0];
   models::User user{
       row["id"].As<std::string>(), row["username"].As<std::string>(),
       row["team_name"].As<std::string>(), row["is_active"].As<bool>()};
+  team_cache_.Invalidate({user.team_name});
 
-  userver::formats::json::ValueBuilder response;
-  response["user"] = user;
-  return userver::formats::json::ToString(response.ExtractValue());
+  return models::ToJsonString(models::UserResponse{user});
 }
 
 }  // namespace prmanager::handlers
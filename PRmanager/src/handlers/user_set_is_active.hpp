@@ -4,6 +4,10 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 
+#include "../components/team_response_cache.hpp"
+#include "../components/team_roster_cache.hpp"
+#include "../metrics/request_metrics.hpp"
+
 namespace prmanager::handlers {
 
 class UserSetIsActiveHandler final
@@ -20,6 +24,9 @@ class UserSetIsActiveHandler final
 
  private:
   userver::storages::postgres::ClusterPtr pg_cluster_;
+  components::TeamRosterCache& roster_cache_;
+  components::TeamResponseCache& team_cache_;
+  metrics::Metrics& metrics_;
 };
 
 }  // namespace prmanager::handlers
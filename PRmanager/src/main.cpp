@@ -4,6 +4,7 @@
 #include <userver/components/component_list.hpp>
 #include <userver/components/minimal_server_component_list.hpp>
 #include <userver/server/handlers/ping.hpp>
+#include <userver/server/handlers/server_monitor.hpp>
 #include <userver/server/handlers/tests_control.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 
@@ -11,26 +12,50 @@
 
 #include <userver/utils/daemon_run.hpp>
 
+#include "components/event_feed.hpp"
+#include "components/group_commit.hpp"
+#include "components/idempotency_cache.hpp"
+#include "components/pull_request_archiver.hpp"
+#include "components/reviewer_assignment.hpp"
+#include "components/stats_aggregates_cache.hpp"
+#include "components/stats_counters.hpp"
+#include "components/team_response_cache.hpp"
+#include "components/team_roster_cache.hpp"
 #include "handlers.hpp"
 
 int main(int argc, char* argv[]) {
   auto component_list =
       userver::components::MinimalServerComponentList()
           .Append<userver::server::handlers::Ping>()
+          .Append<userver::server::handlers::ServerMonitor>()
           .Append<userver::components::TestsuiteSupport>()
           .Append<userver::components::HttpClient>()
           .Append<userver::clients::dns::Component>()
           .Append<userver::server::handlers::TestsControl>()
           .Append<userver::components::Postgres>("postgres-db-1")
+          .Append<prmanager::components::TeamRosterCache>()
+          .Append<prmanager::components::ReviewerAssignment>()
+          .Append<prmanager::components::StatsCounters>()
+          .Append<prmanager::components::StatsAggregatesCache>()
+          .Append<prmanager::components::TeamResponseCache>()
+          .Append<prmanager::components::GroupCommit>()
+          .Append<prmanager::components::IdempotencyCache>()
+          .Append<prmanager::components::EventFeed>()
+          .Append<prmanager::components::PullRequestArchiver>()
           .Append<prmanager::handlers::TeamAddHandler>()
+          .Append<prmanager::handlers::TeamAddBatchHandler>()
           .Append<prmanager::handlers::TeamGetHandler>()
           .Append<prmanager::handlers::UserSetIsActiveHandler>()
           .Append<prmanager::handlers::PullRequestCreateHandler>()
           .Append<prmanager::handlers::PullRequestMergeHandler>()
+          .Append<prmanager::handlers::PullRequestCreateBatchHandler>()
+          .Append<prmanager::handlers::PullRequestMergeBatchHandler>()
           .Append<prmanager::handlers::PullRequestReassignHandler>()
           .Append<prmanager::handlers::UserGetReviewHandler>()
           .Append<prmanager::handlers::MassDeactivateHandler>()
-          .Append<prmanager::handlers::StatsHandler>();
+          .Append<prmanager::handlers::StatsHandler>()
+          .Append<prmanager::handlers::StatsReviewersHandler>()
+          .Append<prmanager::handlers::EventsHandler>();
 
   return userver::utils::DaemonMain(argc, argv, component_list);
 }
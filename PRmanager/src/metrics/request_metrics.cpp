@@ -0,0 +1,102 @@
+#include "request_metrics.hpp"
+
+#include <string_view>
+#include <utility>
+
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/utils/statistics/metric_tag.hpp>
+
+namespace prmanager::metrics {
+
+namespace {
+
+const userver::utils::statistics::MetricTag<Metrics> kMetricsTag{
+    "prmanager.operations"};
+
+template <typename Duration>
+std::int64_t ToMicroseconds(Duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+constexpr std::pair<double, std::string_view> kPercentiles[] = {
+    {50, "p50"}, {95, "p95"}, {99, "p99"}, {99.9, "p99_9"}, {100, "p100"}};
+
+template <typename RecentHistogram>
+void DumpHistogram(userver::utils::statistics::Writer&& writer,
+                   const RecentHistogram& histogram) {
+  const auto stats = histogram.GetStatsForPeriod();
+  for (const auto& [percent, label] : kPercentiles) {
+    writer.ValueWithLabels(
+        stats.GetPercentile(percent),
+        userver::utils::statistics::LabelView{"percentile", label});
+  }
+}
+
+}  // namespace
+
+std::shared_ptr<OperationMetrics> Metrics::ForOperation(
+    const std::string& name) {
+  return operations_[name];
+}
+
+void DumpMetric(userver::utils::statistics::Writer& writer,
+                const OperationMetrics& metrics) {
+  writer["requests"] = metrics.requests;
+  DumpHistogram(writer["total_us"], metrics.total_us);
+  DumpHistogram(writer["postgres_us"], metrics.postgres_us);
+  DumpHistogram(writer["statements"], metrics.statements);
+  DumpHistogram(writer["candidates"], metrics.candidates);
+}
+
+void DumpMetric(userver::utils::statistics::Writer& writer,
+                const Metrics& metrics) {
+  for (const auto& [name, operation] : metrics.operations_) {
+    writer.ValueWithLabels(
+        *operation, userver::utils::statistics::LabelView{"operation", name});
+  }
+}
+
+Metrics& GetMetrics(const userver::components::ComponentContext& context) {
+  return context.FindComponent<userver::components::StatisticsStorage>()
+      .GetMetricsStorage()
+      ->GetMetric(kMetricsTag);
+}
+
+RequestScope::RequestScope(Metrics& metrics, const std::string& operation)
+    : metrics_(metrics.ForOperation(operation)), start_(Clock::now()) {}
+
+RequestScope::~RequestScope() {
+  metrics_->total_us.GetCurrentCounter().Account(
+      ToMicroseconds(Clock::now() - start_));
+  metrics_->postgres_us.GetCurrentCounter().Account(
+      ToMicroseconds(postgres_time_));
+  metrics_->statements.GetCurrentCounter().Account(statements_);
+  ++metrics_->requests;
+}
+
+userver::storages::postgres::Transaction RequestScope::Begin(
+    userver::storages::postgres::Cluster& cluster, const std::string& name,
+    userver::storages::postgres::ClusterHostType host_type,
+    const userver::storages::postgres::TransactionOptions& options) {
+  return TimePostgres([&] { return cluster.Begin(name, host_type, options); });
+}
+
+void RequestScope::Commit(userver::storages::postgres::Transaction& trx) {
+  TimePostgres([&] { trx.Commit(); });
+}
+
+void RequestScope::AccountCandidates(std::size_t count) {
+  metrics_->candidates.GetCurrentCounter().Account(count);
+}
+
+RequestScope::PostgresTimer::PostgresTimer(RequestScope& scope)
+    : scope_(scope), start_(Clock::now()) {}
+
+RequestScope::PostgresTimer::~PostgresTimer() {
+  scope_.postgres_time_ += Clock::now() - start_;
+  ++scope_.statements_;
+}
+
+}  // namespace prmanager::metrics
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <userver/components/component_fwd.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+namespace prmanager::metrics {
+
+// Values are accounted as integers; anything above 2047 lands in the last
+// bucket, which is far beyond any sane count or pool size.
+using Histogram = userver::utils::statistics::RecentPeriod<
+    userver::utils::statistics::Percentile<2048>,
+    userver::utils::statistics::Percentile<2048>>;
+
+// Latencies in microseconds: exact below 1ms, where most of the request
+// path is, then in 1ms steps up to 2s. Slower values land in the last
+// bucket.
+using LatencyPercentile =
+    userver::utils::statistics::Percentile<1000, std::uint32_t, 2000, 1000>;
+using LatencyHistogram =
+    userver::utils::statistics::RecentPeriod<LatencyPercentile,
+                                             LatencyPercentile>;
+
+struct OperationMetrics {
+  LatencyHistogram total_us;
+  LatencyHistogram postgres_us;
+  Histogram statements;
+  Histogram candidates;
+  userver::utils::statistics::RateCounter requests;
+};
+
+// PRmanager metrics, exported under "prmanager.operations" with one
+// "operation" label per handler (pr_create, pr_reassign, ...).
+class Metrics {
+ public:
+  std::shared_ptr<OperationMetrics> ForOperation(const std::string& name);
+
+ private:
+  friend void DumpMetric(userver::utils::statistics::Writer& writer,
+                         const Metrics& metrics);
+
+  userver::rcu::RcuMap<std::string, OperationMetrics> operations_;
+};
+
+void DumpMetric(userver::utils::statistics::Writer& writer,
+                const OperationMetrics& metrics);
+
+void DumpMetric(userver::utils::statistics::Writer& writer,
+                const Metrics& metrics);
+
+Metrics& GetMetrics(const userver::components::ComponentContext& context);
+
+// Measures one request: total time on destruction, plus the time and the
+// number of round trips of every Postgres call made through it.
+class RequestScope final {
+ public:
+  RequestScope(Metrics& metrics, const std::string& operation);
+  ~RequestScope();
+
+  RequestScope(const RequestScope&) = delete;
+  RequestScope& operator=(const RequestScope&) = delete;
+
+  template <typename Func>
+  decltype(auto) TimePostgres(Func&& func) {
+    const PostgresTimer timer{*this};
+    return std::forward<Func>(func)();
+  }
+
+  // Works with both Cluster and Transaction.
+  template <typename Executor, typename... Args>
+  userver::storages::postgres::ResultSet Execute(Executor& executor,
+                                                 Args&&... args) {
+    return TimePostgres(
+        [&] { return executor.Execute(std::forward<Args>(args)...); });
+  }
+
+  userver::storages::postgres::Transaction Begin(
+      userver::storages::postgres::Cluster& cluster, const std::string& name,
+      userver::storages::postgres::ClusterHostType host_type,
+      const userver::storages::postgres::TransactionOptions& options = {});
+
+  void Commit(userver::storages::postgres::Transaction& trx);
+
+  void AccountCandidates(std::size_t count);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  class PostgresTimer final {
+   public:
+    explicit PostgresTimer(RequestScope& scope);
+    ~PostgresTimer();
+
+   private:
+    RequestScope& scope_;
+    Clock::time_point start_;
+  };
+
+  std::shared_ptr<OperationMetrics> metrics_;
+  Clock::time_point start_;
+  Clock::duration postgres_time_{};
+  std::int64_t statements_{0};
+};
+
+}  // namespace prmanager::metrics
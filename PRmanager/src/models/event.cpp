@@ -0,0 +1,24 @@
+#include "event.hpp"
+
+namespace prmanager::models {
+
+void WriteToStream(const Event& event,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("seq");
+  sw.WriteInt64(event.seq);
+  sw.Key("type");
+  sw.WriteString(event.type);
+  if (event.pull_request_id) {
+    sw.Key("pull_request_id");
+    sw.WriteString(*event.pull_request_id);
+  }
+  if (event.user_id) {
+    sw.Key("user_id");
+    sw.WriteString(*event.user_id);
+  }
+  sw.Key("createdAt");
+  sw.WriteString(event.created_at);
+}
+
+}  // namespace prmanager::models
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <userver/formats/json/string_builder.hpp>
+
+namespace prmanager::models {
+
+// One row of the change feed, see the events table.
+struct Event {
+  std::int64_t seq{0};
+  std::string type;
+  std::optional<std::string> pull_request_id;
+  std::optional<std::string> user_id;
+  std::string created_at;
+};
+
+void WriteToStream(const Event& event,
+                   userver::formats::json::StringBuilder& sw);
+
+}  // namespace prmanager::models
@@ -0,0 +1,49 @@
+#include "event_log.hpp"
+
+#include <algorithm>
+
+namespace prmanager::models {
+
+EventLog::EventLog(std::size_t capacity, std::int64_t head)
+    : capacity_(std::max<std::size_t>(capacity, 1)),
+      start_(head),
+      head_(head) {}
+
+std::size_t EventLog::Append(const std::vector<Event>& events,
+                             Snapshot snapshot) {
+  std::size_t appended = 0;
+  for (const auto& event : events) {
+    if (event.seq <= head_) {
+      continue;
+    }
+    if (event.seq != head_ + 1) {
+      if (!gap_xmax_) {
+        gap_xmax_ = snapshot.xmax;
+      }
+      if (snapshot.xmin < *gap_xmax_) {
+        break;
+      }
+    }
+    gap_xmax_.reset();
+    head_ = event.seq;
+    events_.push_back(event);
+    ++appended;
+    if (events_.size() > capacity_) {
+      start_ = events_.front().seq;
+      events_.pop_front();
+    }
+  }
+  return appended;
+}
+
+std::vector<Event> EventLog::Read(std::int64_t since,
+                                  std::size_t limit) const {
+  const auto first = std::upper_bound(
+      events_.begin(), events_.end(), since,
+      [](std::int64_t seq, const Event& event) { return seq < event.seq; });
+  const auto count = std::min<std::size_t>(
+      limit, static_cast<std::size_t>(events_.end() - first));
+  return std::vector<Event>(first, first + count);
+}
+
+}  // namespace prmanager::models
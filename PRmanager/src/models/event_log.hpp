@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "event.hpp"
+
+namespace prmanager::models {
+
+// Bounds of the database snapshot a batch of events was read in, as
+// transaction ids: every transaction below xmin has ended; every
+// transaction that had an id when the snapshot was taken is below xmax.
+struct Snapshot {
+  std::uint64_t xmin{0};
+  std::uint64_t xmax{0};
+};
+
+// The most recent events of the feed, in seq order. Sequence numbers are
+// taken at insert time, so a transaction that is still running leaves a
+// gap that fills up when it commits. Append() stops at such a gap. The
+// transaction holding the missing seq took its id before the event after
+// the gap took its seq, so it is below the xmax of the snapshot that first
+// showed the gap; once a later snapshot has an xmin past that, it has
+// ended, and a gap that is still there is a rollback and is skipped. A
+// reader that has seen seq N never misses a later event with a smaller seq.
+class EventLog {
+ public:
+  // `head` is the last seq that readers may have seen already.
+  EventLog(std::size_t capacity, std::int64_t head);
+
+  // Takes events in seq order, as read from the table after GetHead() in
+  // `snapshot`. Events that were already appended are ignored. Returns how
+  // many were appended; the rest should be read again later.
+  std::size_t Append(const std::vector<Event>& events, Snapshot snapshot);
+
+  // The last seq handed out to readers.
+  std::int64_t GetHead() const { return head_; }
+
+  // Whether every event after `since` (up to the head) is in memory.
+  bool Covers(std::int64_t since) const { return since >= start_; }
+
+  // Up to `limit` events with seq > since. Requires Covers(since).
+  std::vector<Event> Read(std::int64_t since, std::size_t limit) const;
+
+ private:
+  std::size_t capacity_;
+  std::deque<Event> events_;
+  // Events after start_ and up to head_ are in events_.
+  std::int64_t start_;
+  std::int64_t head_;
+  // xmax of the snapshot that first showed the gap after head_.
+  std::optional<std::uint64_t> gap_xmax_;
+};
+
+}  // namespace prmanager::models
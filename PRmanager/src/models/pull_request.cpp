@@ -2,6 +2,28 @@
 
 namespace prmanager::models {
 
+PullRequestCreateRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestCreateRequest>) {
+  return PullRequestCreateRequest{json["pull_request_id"].As<std::string>(),
+                                  json["pull_request_name"].As<std::string>(),
+                                  json["author_id"].As<std::string>()};
+}
+
+PullRequestCreateBatchRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestCreateBatchRequest>) {
+  return PullRequestCreateBatchRequest{
+      json["pull_requests"].As<std::vector<PullRequestCreateRequest>>()};
+}
+
+PullRequestMergeBatchRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestMergeBatchRequest>) {
+  return PullRequestMergeBatchRequest{
+      json["pull_request_ids"].As<std::vector<std::string>>()};
+}
+
 userver::formats::json::Value Serialize(
     const PullRequest& pr,
     userver::formats::serialize::To<userver::formats::json::Value>) {
@@ -27,4 +49,45 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const PullRequest& pr,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("pull_request_id");
+  sw.WriteString(pr.pull_request_id);
+  sw.Key("pull_request_name");
+  sw.WriteString(pr.pull_request_name);
+  sw.Key("author_id");
+  sw.WriteString(pr.author_id);
+  sw.Key("status");
+  sw.WriteString(pr.status);
+  sw.Key("assigned_reviewers");
+  {
+    userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+    for (const auto& reviewer : pr.assigned_reviewers) {
+      sw.WriteString(reviewer);
+    }
+  }
+  if (pr.created_at) {
+    sw.Key("createdAt");
+    sw.WriteString(*pr.created_at);
+  }
+  if (pr.merged_at) {
+    sw.Key("mergedAt");
+    sw.WriteString(*pr.merged_at);
+  }
+}
+
+void WriteToStream(const PullRequestShort& pr,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("pull_request_id");
+  sw.WriteString(pr.pull_request_id);
+  sw.Key("pull_request_name");
+  sw.WriteString(pr.pull_request_name);
+  sw.Key("author_id");
+  sw.WriteString(pr.author_id);
+  sw.Key("status");
+  sw.WriteString(pr.status);
+}
+
 }  // namespace prmanager::models
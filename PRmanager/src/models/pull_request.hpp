@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <userver/formats/json.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/formats/serialize/common_containers.hpp>
 #include <vector>
@@ -26,6 +27,32 @@ struct PullRequestShort {
   std::string status;
 };
 
+struct PullRequestCreateRequest {
+  std::string pull_request_id;
+  std::string pull_request_name;
+  std::string author_id;
+};
+
+struct PullRequestCreateBatchRequest {
+  std::vector<PullRequestCreateRequest> pull_requests;
+};
+
+struct PullRequestMergeBatchRequest {
+  std::vector<std::string> pull_request_ids;
+};
+
+PullRequestCreateRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestCreateRequest>);
+
+PullRequestCreateBatchRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestCreateBatchRequest>);
+
+PullRequestMergeBatchRequest Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<PullRequestMergeBatchRequest>);
+
 userver::formats::json::Value Serialize(
     const PullRequest& pr,
     userver::formats::serialize::To<userver::formats::json::Value>);
@@ -34,4 +61,10 @@ userver::formats::json::Value Serialize(
     const PullRequestShort& pr,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+void WriteToStream(const PullRequest& pr,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const PullRequestShort& pr,
+                   userver::formats::json::StringBuilder& sw);
+
 }  // namespace prmanager::models
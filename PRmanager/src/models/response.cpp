@@ -0,0 +1,115 @@
+#include "response.hpp"
+
+namespace prmanager::models {
+
+void WriteToStream(const ErrorResponse& error,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("error");
+  userver::formats::json::StringBuilder::ObjectGuard error_guard{sw};
+  sw.Key("code");
+  sw.WriteString(error.code);
+  sw.Key("message");
+  sw.WriteString(error.message);
+}
+
+void WriteToStream(const PullRequestResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("pr");
+  WriteToStream(response.pr, sw);
+  if (response.replaced_by) {
+    sw.Key("replaced_by");
+    sw.WriteString(*response.replaced_by);
+  }
+}
+
+void WriteToStream(const TeamResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("team");
+  WriteToStream(response.team, sw);
+}
+
+void WriteToStream(const UserResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("user");
+  WriteToStream(response.user, sw);
+}
+
+void WriteToStream(const ReviewsResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("user_id");
+  sw.WriteString(response.user_id);
+  sw.Key("pull_requests");
+  {
+    userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+    for (const auto& pr : response.pull_requests) {
+      WriteToStream(pr, sw);
+    }
+  }
+  if (response.next_cursor) {
+    sw.Key("next_cursor");
+    sw.WriteString(*response.next_cursor);
+  }
+}
+
+void WriteToStream(const TeamAddResult& result,
+                   userver::formats::json::StringBuilder& sw) {
+  if (result.error) {
+    WriteToStream(*result.error, sw);
+    return;
+  }
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("team");
+  WriteToStream(*result.team, sw);
+}
+
+void WriteToStream(const TeamAddBatchResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("results");
+  userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+  for (const auto& result : response.results) {
+    WriteToStream(result, sw);
+  }
+}
+
+void WriteToStream(const PullRequestResult& result,
+                   userver::formats::json::StringBuilder& sw) {
+  if (result.error) {
+    WriteToStream(*result.error, sw);
+    return;
+  }
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("pr");
+  WriteToStream(*result.pr, sw);
+}
+
+void WriteToStream(const PullRequestBatchResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("results");
+  userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+  for (const auto& result : response.results) {
+    WriteToStream(result, sw);
+  }
+}
+
+void WriteToStream(const EventsResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("events");
+  {
+    userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+    for (const auto& event : response.events) {
+      WriteToStream(event, sw);
+    }
+  }
+  sw.Key("next_since");
+  sw.WriteInt64(response.next_since);
+}
+
+}  // namespace prmanager::models
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <userver/formats/json/string_builder.hpp>
+#include <vector>
+
+#include "event.hpp"
+#include "pull_request.hpp"
+#include "team.hpp"
+#include "user.hpp"
+
+namespace prmanager::models {
+
+// Response envelopes written straight into the output buffer without
+// building an intermediate json::Value.
+
+struct ErrorResponse {
+  std::string code;
+  std::string message;
+};
+
+struct PullRequestResponse {
+  PullRequest pr;
+  std::optional<std::string> replaced_by;
+};
+
+struct TeamResponse {
+  Team team;
+};
+
+struct UserResponse {
+  User user;
+};
+
+struct ReviewsResponse {
+  std::string user_id;
+  std::vector<PullRequestShort> pull_requests;
+  std::optional<std::string> next_cursor;
+};
+
+// Exactly one of the fields is set.
+struct TeamAddResult {
+  std::optional<Team> team;
+  std::optional<ErrorResponse> error;
+};
+
+struct TeamAddBatchResponse {
+  std::vector<TeamAddResult> results;
+};
+
+// Exactly one of the fields is set.
+struct PullRequestResult {
+  std::optional<PullRequest> pr;
+  std::optional<ErrorResponse> error;
+};
+
+struct PullRequestBatchResponse {
+  std::vector<PullRequestResult> results;
+};
+
+struct EventsResponse {
+  std::vector<Event> events;
+  std::int64_t next_since{0};
+};
+
+void WriteToStream(const ErrorResponse& error,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const PullRequestResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const TeamResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const UserResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const ReviewsResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const TeamAddResult& result,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const TeamAddBatchResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const PullRequestResult& result,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const PullRequestBatchResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const EventsResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+template <typename T>
+std::string ToJsonString(const T& value) {
+  userver::formats::json::StringBuilder sw;
+  WriteToStream(value, sw);
+  return sw.GetString();
+}
+
+}  // namespace prmanager::models
@@ -0,0 +1,76 @@
+#include "review_load_index.hpp"
+#include "../utils/random.hpp"
+
+#include <algorithm>
+
+namespace prmanager::models {
+
+bool ReviewLoadIndex::SetMember(const std::string& user_id,
+                                const std::string& team_name,
+                                bool is_active) {
+  auto& member = members_[user_id];
+  if (member.team_name == team_name && member.is_active == is_active) {
+    return false;
+  }
+
+  Unindex(user_id, member);
+  member.team_name = team_name;
+  member.is_active = is_active;
+  Index(user_id, member);
+  return true;
+}
+
+void ReviewLoadIndex::SetLoad(const std::string& user_id, std::int64_t load) {
+  auto& member = members_[user_id];
+  load = std::max<std::int64_t>(load, 0);
+  if (member.load == load) {
+    return;
+  }
+
+  Unindex(user_id, member);
+  member.load = load;
+  Index(user_id, member);
+}
+
+void ReviewLoadIndex::AddLoad(const std::string& user_id,
+                              std::int64_t delta) {
+  SetLoad(user_id, GetLoad(user_id) + delta);
+}
+
+std::int64_t ReviewLoadIndex::GetLoad(const std::string& user_id) const {
+  const auto it = members_.find(user_id);
+  return it == members_.end() ? 0 : it->second.load;
+}
+
+std::size_t ReviewLoadIndex::GetActiveCount(
+    const std::string& team_name) const {
+  const auto it = by_team_.find(team_name);
+  return it == by_team_.end() ? 0 : it->second.size();
+}
+
+std::size_t ReviewLoadIndex::size() const { return members_.size(); }
+
+void ReviewLoadIndex::Unindex(const std::string& user_id,
+                              const Member& member) {
+  if (!member.is_active) {
+    return;
+  }
+
+  const auto team_it = by_team_.find(member.team_name);
+  if (team_it == by_team_.end()) {
+    return;
+  }
+  team_it->second.erase({member.load, member.tiebreak, user_id});
+  if (team_it->second.empty()) {
+    by_team_.erase(team_it);
+  }
+}
+
+void ReviewLoadIndex::Index(const std::string& user_id, Member& member) {
+  if (member.is_active) {
+    member.tiebreak = utils::WithRng([](auto& rng) { return rng(); });
+    by_team_[member.team_name].emplace(member.load, member.tiebreak, user_id);
+  }
+}
+
+}  // namespace prmanager::models
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace prmanager::models {
+
+// Number of open PRs assigned to every user, with the active members of each
+// team ordered by that number. Picking the least loaded reviewers costs
+// O(log n) plus the number of skipped (excluded) members.
+class ReviewLoadIndex {
+ public:
+  // Adds the user or moves it to another team / activity state, keeping the
+  // current load. Returns whether anything changed.
+  bool SetMember(const std::string& user_id, const std::string& team_name,
+                 bool is_active);
+
+  void SetLoad(const std::string& user_id, std::int64_t load);
+
+  // Loads never go below zero, so a decrement that raced with a reload from
+  // the database is harmless.
+  void AddLoad(const std::string& user_id, std::int64_t delta);
+
+  std::int64_t GetLoad(const std::string& user_id) const;
+
+  // Up to `count` active members of the team with the smallest loads.
+  // `is_excluded(user_id)` filters out candidates. Members with equal loads
+  // come in a random order that is reshuffled whenever a load changes, so
+  // ties do not always go to the same users.
+  template <typename IsExcluded>
+  std::vector<std::string> PickLeastLoaded(const std::string& team_name,
+                                           std::size_t count,
+                                           IsExcluded&& is_excluded) const {
+    std::vector<std::string> picked;
+    const auto it = by_team_.find(team_name);
+    if (it == by_team_.end()) {
+      return picked;
+    }
+    for (const auto& [load, tiebreak, user_id] : it->second) {
+      if (picked.size() == count) {
+        break;
+      }
+      if (!is_excluded(user_id)) {
+        picked.push_back(user_id);
+      }
+    }
+    return picked;
+  }
+
+  std::size_t GetActiveCount(const std::string& team_name) const;
+
+  std::size_t size() const;
+
+ private:
+  struct Member {
+    std::string team_name;
+    bool is_active{false};
+    std::int64_t load{0};
+    std::uint64_t tiebreak{0};
+  };
+
+  using TeamIndex =
+      std::set<std::tuple<std::int64_t, std::uint64_t, std::string>>;
+
+  void Unindex(const std::string& user_id, const Member& member);
+  // Draws a new tiebreak for the member.
+  void Index(const std::string& user_id, Member& member);
+
+  std::unordered_map<std::string, Member> members_;
+  std::unordered_map<std::string, TeamIndex> by_team_;
+};
+
+}  // namespace prmanager::models
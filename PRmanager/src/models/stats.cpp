@@ -10,6 +10,25 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+userver::formats::json::Value Serialize(
+    const TeamLoad& load,
+    userver::formats::serialize::To<userver::formats::json::Value>) {
+  userver::formats::json::ValueBuilder builder;
+  builder["team_name"] = load.team_name;
+  builder["open_prs_count"] = load.open_prs_count;
+  return builder.ExtractValue();
+}
+
+userver::formats::json::Value Serialize(
+    const ReviewerLoad& load,
+    userver::formats::serialize::To<userver::formats::json::Value>) {
+  userver::formats::json::ValueBuilder builder;
+  builder["user_id"] = load.user_id;
+  builder["open_count"] = load.open_count;
+  builder["total_count"] = load.total_count;
+  return builder.ExtractValue();
+}
+
 userver::formats::json::Value Serialize(
     const StatsResponse& response,
     userver::formats::serialize::To<userver::formats::json::Value>) {
@@ -17,7 +36,90 @@ userver::formats::json::Value Serialize(
   builder["teams_count"] = response.teams_count;
   builder["users_count"] = response.users_count;
   builder["prs_count"] = response.prs_count;
+  builder["open_prs_count"] = response.open_prs_count;
+  builder["merged_prs_count"] = response.merged_prs_count;
+  if (response.mean_time_to_merge_seconds) {
+    builder["mean_time_to_merge_seconds"] =
+        *response.mean_time_to_merge_seconds;
+  }
+  builder["teams_load"] = response.teams_load;
+  return builder.ExtractValue();
+}
+
+userver::formats::json::Value Serialize(
+    const ReviewerStatsResponse& response,
+    userver::formats::serialize::To<userver::formats::json::Value>) {
+  userver::formats::json::ValueBuilder builder;
+  builder["reviewers"] = response.reviewers;
+  if (response.next_cursor) builder["next_cursor"] = *response.next_cursor;
   return builder.ExtractValue();
 }
 
+void WriteToStream(const MassDeactivateResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("deactivated_count");
+  sw.WriteInt64(response.deactivated_count);
+}
+
+void WriteToStream(const TeamLoad& load,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("team_name");
+  sw.WriteString(load.team_name);
+  sw.Key("open_prs_count");
+  sw.WriteInt64(load.open_prs_count);
+}
+
+void WriteToStream(const ReviewerLoad& load,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("user_id");
+  sw.WriteString(load.user_id);
+  sw.Key("open_count");
+  sw.WriteInt64(load.open_count);
+  sw.Key("total_count");
+  sw.WriteInt64(load.total_count);
+}
+
+void WriteToStream(const StatsResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("teams_count");
+  sw.WriteInt64(response.teams_count);
+  sw.Key("users_count");
+  sw.WriteInt64(response.users_count);
+  sw.Key("prs_count");
+  sw.WriteInt64(response.prs_count);
+  sw.Key("open_prs_count");
+  sw.WriteInt64(response.open_prs_count);
+  sw.Key("merged_prs_count");
+  sw.WriteInt64(response.merged_prs_count);
+  if (response.mean_time_to_merge_seconds) {
+    sw.Key("mean_time_to_merge_seconds");
+    sw.WriteDouble(*response.mean_time_to_merge_seconds);
+  }
+  sw.Key("teams_load");
+  userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+  for (const auto& load : response.teams_load) {
+    WriteToStream(load, sw);
+  }
+}
+
+void WriteToStream(const ReviewerStatsResponse& response,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("reviewers");
+  {
+    userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+    for (const auto& load : response.reviewers) {
+      WriteToStream(load, sw);
+    }
+  }
+  if (response.next_cursor) {
+    sw.Key("next_cursor");
+    sw.WriteString(*response.next_cursor);
+  }
+}
+
 }  // namespace prmanager::models
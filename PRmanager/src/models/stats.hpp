@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <userver/formats/json.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+#include <vector>
 
 namespace prmanager::models {
 
@@ -8,18 +14,65 @@ struct MassDeactivateResponse {
   int deactivated_count;
 };
 
+struct TeamLoad {
+  std::string team_name;
+  std::int64_t open_prs_count;
+};
+
+struct ReviewerLoad {
+  std::string user_id;
+  std::int64_t open_count;
+  std::int64_t total_count;
+};
+
 struct StatsResponse {
-  int teams_count;
-  int users_count;
-  int prs_count;
+  std::int64_t teams_count;
+  std::int64_t users_count;
+  std::int64_t prs_count;
+  std::int64_t open_prs_count = 0;
+  std::int64_t merged_prs_count = 0;
+  std::optional<double> mean_time_to_merge_seconds;
+  std::vector<TeamLoad> teams_load;
+};
+
+struct ReviewerStatsResponse {
+  std::vector<ReviewerLoad> reviewers;
+  std::optional<std::string> next_cursor;
 };
 
 userver::formats::json::Value Serialize(
     const MassDeactivateResponse& response,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+userver::formats::json::Value Serialize(
+    const TeamLoad& load,
+    userver::formats::serialize::To<userver::formats::json::Value>);
+
+userver::formats::json::Value Serialize(
+    const ReviewerLoad& load,
+    userver::formats::serialize::To<userver::formats::json::Value>);
+
 userver::formats::json::Value Serialize(
     const StatsResponse& response,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+userver::formats::json::Value Serialize(
+    const ReviewerStatsResponse& response,
+    userver::formats::serialize::To<userver::formats::json::Value>);
+
+void WriteToStream(const MassDeactivateResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const TeamLoad& load,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const ReviewerLoad& load,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const StatsResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const ReviewerStatsResponse& response,
+                   userver::formats::json::StringBuilder& sw);
+
 }  // namespace prmanager::models
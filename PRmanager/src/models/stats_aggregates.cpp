@@ -0,0 +1,103 @@
+#include "stats_aggregates.hpp"
+
+#include <algorithm>
+
+namespace prmanager::models {
+
+namespace {
+
+constexpr std::string_view kOpen = "OPEN";
+
+}  // namespace
+
+void StatsAggregates::Apply(const std::string& pr_id, PullRequestState state) {
+  if (merged_.count(pr_id) > 0) {
+    return;
+  }
+  if (const auto it = open_.find(pr_id); it != open_.end()) {
+    Account(it->second, -1);
+    open_.erase(it);
+  }
+
+  Account(state, 1);
+  if (state.status == kOpen) {
+    open_.emplace(pr_id, std::move(state));
+  } else {
+    merged_.insert(pr_id);
+  }
+}
+
+std::int64_t StatsAggregates::GetOpenCount() const { return open_count_; }
+
+std::int64_t StatsAggregates::GetMergedCount() const { return merged_count_; }
+
+std::optional<double> StatsAggregates::GetMeanTimeToMergeSeconds() const {
+  if (timed_merged_count_ == 0) {
+    return std::nullopt;
+  }
+  return static_cast<double>(merge_seconds_sum_) / timed_merged_count_;
+}
+
+std::vector<TeamLoad> StatsAggregates::GetTeamsLoad() const {
+  std::vector<TeamLoad> teams;
+  teams.reserve(teams_open_.size());
+  for (const auto& [team_name, open_prs] : teams_open_) {
+    teams.push_back(TeamLoad{team_name, open_prs});
+  }
+  std::sort(teams.begin(), teams.end(),
+            [](const TeamLoad& lhs, const TeamLoad& rhs) {
+              if (lhs.open_prs_count != rhs.open_prs_count) {
+                return lhs.open_prs_count > rhs.open_prs_count;
+              }
+              return lhs.team_name < rhs.team_name;
+            });
+  return teams;
+}
+
+std::vector<ReviewerLoad> StatsAggregates::GetReviewers(
+    const std::string& cursor, std::size_t limit) const {
+  std::vector<ReviewerLoad> reviewers;
+  auto it = cursor.empty() ? reviewers_.begin()
+                           : reviewers_.upper_bound(cursor);
+  for (; it != reviewers_.end() && reviewers.size() < limit; ++it) {
+    reviewers.push_back(
+        ReviewerLoad{it->first, it->second.open, it->second.total});
+  }
+  return reviewers;
+}
+
+void StatsAggregates::Account(const PullRequestState& state,
+                              std::int64_t sign) {
+  const bool is_open = state.status == kOpen;
+
+  for (const auto& reviewer_id : state.reviewers) {
+    auto& counts = reviewers_[reviewer_id];
+    counts.total += sign;
+    if (is_open) {
+      counts.open += sign;
+    }
+    if (counts.total == 0 && counts.open == 0) {
+      reviewers_.erase(reviewer_id);
+    }
+  }
+
+  if (is_open) {
+    open_count_ += sign;
+    auto& team_open = teams_open_[state.team_name];
+    team_open += sign;
+    if (team_open == 0) {
+      teams_open_.erase(state.team_name);
+    }
+    return;
+  }
+
+  merged_count_ += sign;
+  if (state.created_at && state.merged_at) {
+    const auto merge_time = std::chrono::duration_cast<std::chrono::seconds>(
+        *state.merged_at - *state.created_at);
+    timed_merged_count_ += sign;
+    merge_seconds_sum_ += sign * merge_time.count();
+  }
+}
+
+}  // namespace prmanager::models
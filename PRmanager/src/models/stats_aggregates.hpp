@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "stats.hpp"
+
+namespace prmanager::models {
+
+struct PullRequestState {
+  std::string status;
+  std::string team_name;
+  std::vector<std::string> reviewers;
+  std::optional<std::chrono::system_clock::time_point> created_at;
+  std::optional<std::chrono::system_clock::time_point> merged_at;
+};
+
+// Review load aggregates maintained from pull request rows, read again
+// whenever the event feed reports a change. Rows are applied in the order
+// they were read, so the state of an open PR simply replaces its previous
+// contribution. Merged PRs are final: only their ids are kept, so that a
+// re-read (an event that followed the merge) is not counted twice.
+class StatsAggregates {
+ public:
+  void Apply(const std::string& pr_id, PullRequestState state);
+
+  // The last event of the feed whose PR has been applied.
+  std::int64_t GetEventsHead() const { return events_head_; }
+  void SetEventsHead(std::int64_t seq) { events_head_ = seq; }
+
+  std::int64_t GetOpenCount() const;
+  std::int64_t GetMergedCount() const;
+  std::optional<double> GetMeanTimeToMergeSeconds() const;
+
+  // Open PR count per author team, busiest teams first.
+  std::vector<TeamLoad> GetTeamsLoad() const;
+
+  // Reviewers ordered by user_id, starting after `cursor`.
+  std::vector<ReviewerLoad> GetReviewers(const std::string& cursor,
+                                         std::size_t limit) const;
+
+ private:
+  struct ReviewerCounts {
+    std::int64_t open = 0;
+    std::int64_t total = 0;
+  };
+
+  void Account(const PullRequestState& state, std::int64_t sign);
+
+  std::unordered_map<std::string, PullRequestState> open_;
+  std::unordered_set<std::string> merged_;
+  std::map<std::string, ReviewerCounts> reviewers_;
+  std::unordered_map<std::string, std::int64_t> teams_open_;
+  std::int64_t open_count_ = 0;
+  std::int64_t merged_count_ = 0;
+  std::int64_t timed_merged_count_ = 0;
+  std::int64_t merge_seconds_sum_ = 0;
+  std::int64_t events_head_ = 0;
+};
+
+}  // namespace prmanager::models
@@ -15,6 +15,11 @@ Team Parse(const userver::formats::json::Value& json,
               json["members"].As<std::vector<TeamMember>>()};
 }
 
+TeamAddBatchRequest Parse(const userver::formats::json::Value& json,
+                          userver::formats::parse::To<TeamAddBatchRequest>) {
+  return TeamAddBatchRequest{json["teams"].As<std::vector<Team>>()};
+}
+
 userver::formats::json::Value Serialize(
     const TeamMember& member,
     userver::formats::serialize::To<userver::formats::json::Value>) {
@@ -34,4 +39,27 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const TeamMember& member,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("user_id");
+  sw.WriteString(member.user_id);
+  sw.Key("username");
+  sw.WriteString(member.username);
+  sw.Key("is_active");
+  sw.WriteBool(member.is_active);
+}
+
+void WriteToStream(const Team& team,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("team_name");
+  sw.WriteString(team.team_name);
+  sw.Key("members");
+  userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+  for (const auto& member : team.members) {
+    WriteToStream(member, sw);
+  }
+}
+
 }  // namespace prmanager::models
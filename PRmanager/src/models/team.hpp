@@ -2,6 +2,7 @@
 
 #include <string>
 #include <userver/formats/json.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/formats/serialize/common_containers.hpp>
 #include <vector>
@@ -19,14 +20,26 @@ struct Team {
   std::vector<TeamMember> members;
 };
 
+struct TeamAddBatchRequest {
+  std::vector<Team> teams;
+};
+
 TeamMember Parse(const userver::formats::json::Value& json,
                  userver::formats::parse::To<TeamMember>);
 
 Team Parse(const userver::formats::json::Value& json,
            userver::formats::parse::To<Team>);
 
+TeamAddBatchRequest Parse(const userver::formats::json::Value& json,
+                          userver::formats::parse::To<TeamAddBatchRequest>);
+
 userver::formats::json::Value Serialize(
     const Team& team,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+void WriteToStream(const TeamMember& member,
+                   userver::formats::json::StringBuilder& sw);
+
+void WriteToStream(const Team& team, userver::formats::json::StringBuilder& sw);
+
 }  // namespace prmanager::models
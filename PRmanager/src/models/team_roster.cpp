@@ -0,0 +1,114 @@
+#include "team_roster.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace prmanager::models {
+
+TeamRoster::TeamRoster(const TeamRoster& other)
+    : users_(other.users_),
+      active_by_team_(other.active_by_team_),
+      size_(other.size_) {}
+
+const RosterMember* TeamRoster::FindUser(const std::string& user_id) const {
+  const auto& shard = users_[GetShardIndex(user_id)];
+  if (!shard) {
+    return nullptr;
+  }
+  const auto it = shard->find(user_id);
+  return it == shard->end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> TeamRoster::GetActiveMembers(
+    const std::string& team_name,
+    const std::vector<std::string>& excluded) const {
+  std::vector<std::string> members;
+  const auto it = active_by_team_.find(team_name);
+  if (it == active_by_team_.end()) {
+    return members;
+  }
+
+  members.reserve(it->second->size());
+  for (const auto& user_id : *it->second) {
+    if (std::find(excluded.begin(), excluded.end(), user_id) ==
+        excluded.end()) {
+      members.push_back(user_id);
+    }
+  }
+  return members;
+}
+
+bool TeamRoster::Upsert(RosterMember member) {
+  const auto* current = FindUser(member.user_id);
+  if (current) {
+    if (current->updated_at > member.updated_at) {
+      return false;
+    }
+    RemoveFromTeam(*current);
+  } else {
+    ++size_;
+  }
+
+  if (member.is_active) {
+    GetMutableTeam(member.team_name).push_back(member.user_id);
+  }
+  auto& users = GetMutableShard(member.user_id);
+  auto user_id = member.user_id;
+  const auto it =
+      users.insert_or_assign(std::move(user_id), std::move(member)).first;
+  // Nodes of an owned shard are never moved or cloned again.
+  changes_.push_back(&it->second);
+  return true;
+}
+
+const std::vector<const RosterMember*>& TeamRoster::GetChanges() const {
+  return changes_;
+}
+
+std::size_t TeamRoster::size() const { return size_; }
+
+std::size_t TeamRoster::GetShardIndex(const std::string& user_id) {
+  return std::hash<std::string>{}(user_id) % kUserShards;
+}
+
+TeamRoster::Users& TeamRoster::GetMutableShard(const std::string& user_id) {
+  const auto index = GetShardIndex(user_id);
+  auto& shard = users_[index];
+  if (!shard) {
+    shard = std::make_shared<Users>();
+  } else if (!owned_shards_[index]) {
+    shard = std::make_shared<Users>(*shard);
+  }
+  owned_shards_[index] = true;
+  return *shard;
+}
+
+TeamRoster::Members& TeamRoster::GetMutableTeam(const std::string& team_name) {
+  auto& members = active_by_team_[team_name];
+  const bool owned = !owned_teams_.insert(team_name).second;
+  if (!members) {
+    members = std::make_shared<Members>();
+  } else if (!owned) {
+    members = std::make_shared<Members>(*members);
+  }
+  return *members;
+}
+
+void TeamRoster::RemoveFromTeam(const RosterMember& member) {
+  if (!member.is_active ||
+      active_by_team_.find(member.team_name) == active_by_team_.end()) {
+    return;
+  }
+
+  auto& members = GetMutableTeam(member.team_name);
+  const auto it = std::find(members.begin(), members.end(), member.user_id);
+  if (it != members.end()) {
+    *it = std::move(members.back());
+    members.pop_back();
+  }
+  if (members.empty()) {
+    active_by_team_.erase(member.team_name);
+  }
+}
+
+}  // namespace prmanager::models
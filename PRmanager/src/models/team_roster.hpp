@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace prmanager::models {
+
+struct RosterMember {
+  std::string user_id;
+  std::string team_name;
+  bool is_active;
+  std::chrono::system_clock::time_point updated_at;
+};
+
+// Snapshot of all users grouped by team. Active members of every team are
+// kept in a flat vector so that candidate selection never touches the DB.
+//
+// Users are split into shards. A copy shares the shards and team vectors
+// with the original, and Upsert clones only the ones it touches. A write
+// then costs the size of what it changes, not the size of the roster.
+class TeamRoster {
+ public:
+  TeamRoster() = default;
+
+  // Starts the next snapshot. It shares all data with `other` but does not
+  // inherit its changes.
+  TeamRoster(const TeamRoster& other);
+  TeamRoster& operator=(const TeamRoster&) = delete;
+
+  const RosterMember* FindUser(const std::string& user_id) const;
+
+  // Active members of the team without the ids listed in `excluded`.
+  std::vector<std::string> GetActiveMembers(
+      const std::string& team_name,
+      const std::vector<std::string>& excluded) const;
+
+  // Inserts or replaces the member unless the stored row is newer.
+  // Returns whether the snapshot was changed.
+  bool Upsert(RosterMember member);
+
+  // Members stored by Upsert since this snapshot was created, in order.
+  // A user upserted twice appears twice.
+  const std::vector<const RosterMember*>& GetChanges() const;
+
+  std::size_t size() const;
+
+ private:
+  using Users = std::unordered_map<std::string, RosterMember>;
+  using Members = std::vector<std::string>;
+
+  static constexpr std::size_t kUserShards = 64;
+
+  static std::size_t GetShardIndex(const std::string& user_id);
+
+  Users& GetMutableShard(const std::string& user_id);
+  Members& GetMutableTeam(const std::string& team_name);
+  void RemoveFromTeam(const RosterMember& member);
+
+  std::array<std::shared_ptr<Users>, kUserShards> users_;
+  std::unordered_map<std::string, std::shared_ptr<Members>> active_by_team_;
+  std::size_t size_{0};
+
+  // Parts cloned by this snapshot, which Upsert may modify in place. All
+  // other parts may be shared with published snapshots.
+  std::array<bool, kUserShards> owned_shards_{};
+  std::unordered_set<std::string> owned_teams_;
+  std::vector<const RosterMember*> changes_;
+};
+
+}  // namespace prmanager::models
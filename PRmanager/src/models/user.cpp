@@ -13,6 +13,19 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const User& user,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("user_id");
+  sw.WriteString(user.user_id);
+  sw.Key("username");
+  sw.WriteString(user.username);
+  sw.Key("team_name");
+  sw.WriteString(user.team_name);
+  sw.Key("is_active");
+  sw.WriteBool(user.is_active);
+}
+
 MassDeactivateRequest Parse(
     const userver::formats::json::Value& json,
     userver::formats::parse::To<MassDeactivateRequest>) {
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <userver/formats/json.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/formats/serialize/common_containers.hpp>
 #include <vector>
@@ -23,6 +24,8 @@ userver::formats::json::Value Serialize(
     const User& user,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+void WriteToStream(const User& user, userver::formats::json::StringBuilder& sw);
+
 MassDeactivateRequest Parse(const userver::formats::json::Value& json,
                             userver::formats::parse::To<MassDeactivateRequest>);
 
@@ -0,0 +1,79 @@
+#include "random.hpp"
+
+#include <atomic>
+#include <random>
+
+namespace prmanager::utils {
+
+namespace {
+
+std::uint64_t SplitMix64(std::uint64_t& x) {
+  std::uint64_t z = (x += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+std::uint64_t Rotl(std::uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+// Bumped on every SetDeterministicSeed() so that threads reseed lazily.
+std::atomic<std::uint64_t> seed_generation{0};
+std::atomic<bool> is_deterministic{false};
+std::atomic<std::uint64_t> deterministic_seed{0};
+
+std::uint64_t MakeSeed() {
+  if (is_deterministic.load()) {
+    return deterministic_seed.load();
+  }
+  std::random_device device;
+  return (std::uint64_t{device()} << 32) ^ device();
+}
+
+struct ThreadRng {
+  Xoshiro256 rng;
+  std::uint64_t generation;
+};
+
+}  // namespace
+
+Xoshiro256::Xoshiro256(std::uint64_t seed) {
+  for (auto& word : state_) {
+    word = SplitMix64(seed);
+  }
+}
+
+Xoshiro256::result_type Xoshiro256::operator()() {
+  const auto result = Rotl(state_[1] * 5, 7) * 9;
+  const auto t = state_[1] << 17;
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = Rotl(state_[3], 45);
+  return result;
+}
+
+namespace impl {
+
+Xoshiro256& GetThreadRng() {
+  thread_local ThreadRng thread_rng{Xoshiro256{MakeSeed()},
+                                    seed_generation.load()};
+  const auto generation = seed_generation.load(std::memory_order_relaxed);
+  if (thread_rng.generation != generation) {
+    thread_rng = ThreadRng{Xoshiro256{MakeSeed()}, generation};
+  }
+  return thread_rng.rng;
+}
+
+}  // namespace impl
+
+void SetDeterministicSeed(std::optional<std::uint64_t> seed) {
+  is_deterministic = seed.has_value();
+  deterministic_seed = seed.value_or(0);
+  ++seed_generation;
+}
+
+}  // namespace prmanager::utils
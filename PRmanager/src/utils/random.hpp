@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace prmanager::utils {
+
+// xoshiro256**: 32 bytes of state, a few cycles per number. Satisfies
+// UniformRandomBitGenerator, so it works with std::sample and the standard
+// distributions.
+class Xoshiro256 final {
+ public:
+  using result_type = std::uint64_t;
+
+  explicit Xoshiro256(std::uint64_t seed);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()();
+
+ private:
+  std::uint64_t state_[4];
+};
+
+namespace impl {
+
+Xoshiro256& GetThreadRng();
+
+}  // namespace impl
+
+// Runs `func(rng)` with the generator of the current thread. `func` must not
+// suspend the coroutine: the task may resume on another thread.
+template <typename Func>
+decltype(auto) WithRng(Func&& func) {
+  return std::forward<Func>(func)(impl::GetThreadRng());
+}
+
+// With a seed, every thread generator restarts from it, which makes picks
+// reproducible in single-threaded tests. std::nullopt returns to seeding
+// from std::random_device.
+void SetDeterministicSeed(std::optional<std::uint64_t> seed);
+
+}  // namespace prmanager::utils
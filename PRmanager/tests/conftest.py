@@ -1,3 +1,5 @@
+import re
+
 import pytest
 
 from testsuite.databases.pgsql import discover
@@ -26,6 +28,19 @@ def pgsql_local(service_source_dir, pgsql_local_create):
     return pgsql_local_create(list(databases.values()))
 
 
+_QUERY = re.compile(
+    r'inline const Query k\w+\{(.*?)Query::Name\{"(\w+)"\}\};', re.S)
+_LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+
+@pytest.fixture(scope="session")
+def queries(service_source_dir):
+    """SQL of src/db/queries.hpp by query name."""
+    source = (service_source_dir / "src/db/queries.hpp").read_text()
+    return {name: "".join(_LITERAL.findall(body))
+            for body, name in _QUERY.findall(source)}
+
+
 @pytest.fixture
 def create_team(service_client):
     """Return a helper to create teams during tests."""
@@ -0,0 +1,94 @@
+import json
+
+
+def _relations(plan):
+    found = [plan["Relation Name"]] if "Relation Name" in plan else []
+    for child in plan.get("Plans", []):
+        found.extend(_relations(child))
+    return found
+
+
+def _archive(cursor, merged_month):
+    cursor.execute("SELECT prmanager.archive_merged_month(%s)",
+                   (merged_month,))
+    return cursor.fetchone()[0]
+
+
+async def test_archived_pr(service_client, pgsql, queries):
+    team_data = {
+        "team_name": "archive",
+        "members": [
+            {"user_id": "ar1", "username": "A", "is_active": True},
+            {"user_id": "ar2", "username": "B", "is_active": True},
+            {"user_id": "ar3", "username": "C", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    pr_data = {"pull_request_id": "pr-archived",
+               "pull_request_name": "Old change", "author_id": "ar1"}
+    response = await service_client.post("/pullRequest/create", json=pr_data)
+    reviewers = response.json()["pr"]["assigned_reviewers"]
+    assert len(reviewers) == 2
+    await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-archived"})
+    await service_client.post("/pullRequest/create", json={
+        "pull_request_id": "pr-recent", "pull_request_name": "New change",
+        "author_id": "ar1"})
+
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute(
+        "UPDATE prmanager.pull_requests "
+        "SET merged_at = '2001-01-15T12:00:00+00:00' WHERE id = 'pr-archived'")
+    try:
+        assert _archive(cursor, "2001-01-01") == 1
+        # A month is archived once.
+        assert _archive(cursor, "2001-01-01") == 0
+        cursor.execute(
+            "SELECT tableoid::regclass::text FROM prmanager.pull_requests "
+            "WHERE id = 'pr-archived'")
+        assert cursor.fetchone()[0] == "prmanager.pull_requests_2001_01"
+        cursor.execute(
+            "SELECT COUNT(*) FROM prmanager.reviewers_2001_01")
+        assert cursor.fetchone()[0] == 2
+
+        response = await service_client.get(
+            "/users/getReview", params={"user_id": reviewers[0]})
+        assert response.status == 200
+        prs = response.json()["pull_requests"]
+        assert [pr["pull_request_id"] for pr in prs
+                if pr["status"] == "MERGED"] == ["pr-archived"]
+
+        response = await service_client.post(
+            "/pullRequest/merge", json={"pull_request_id": "pr-archived"})
+        assert response.status == 200
+        data = response.json()["pr"]
+        assert data["status"] == "MERGED"
+        assert sorted(data["assigned_reviewers"]) == sorted(reviewers)
+
+        response = await service_client.post("/pullRequest/reassign", json={
+            "pull_request_id": "pr-archived", "old_user_id": reviewers[0]})
+        assert response.status == 409
+        assert response.json()["error"]["code"] == "PR_MERGED"
+
+        response = await service_client.post(
+            "/pullRequest/create", json=pr_data)
+        assert response.status == 409
+        assert response.json()["error"]["code"] == "PR_EXISTS"
+
+        # Open reviews never read the archive.
+        cursor.execute(f"PREPARE open_reviews AS {queries['select_reviews']}")
+        try:
+            cursor.execute(
+                "EXPLAIN (FORMAT JSON) EXECUTE open_reviews("
+                "%s, 'OPEN', NULL, NULL, NULL)", (reviewers[0],))
+            plan = cursor.fetchone()[0]
+            if isinstance(plan, str):
+                plan = json.loads(plan)
+        finally:
+            cursor.execute("DEALLOCATE open_reviews")
+        relations = _relations(plan[0]["Plan"])
+        assert "reviewers_hot" in relations
+        assert not any(r.endswith("_2001_01") for r in relations), relations
+    finally:
+        cursor.execute("DROP TABLE IF EXISTS prmanager.reviewers_2001_01, "
+                       "prmanager.pull_requests_2001_01")
@@ -0,0 +1,127 @@
+import asyncio
+
+import pytest
+
+
+async def _head(service_client):
+    response = await service_client.get("/events")
+    assert response.status == 200
+    assert response.json()["events"] == []
+    return response.json()["next_since"]
+
+
+async def _collect(service_client, since, count):
+    events = []
+    while len(events) < count:
+        response = await service_client.get(
+            "/events", params={"since": since, "timeout_ms": 5000})
+        assert response.status == 200
+        data = response.json()
+        assert data["events"], "no events within the long poll timeout"
+        events.extend(data["events"])
+        since = data["next_since"]
+    return events, since
+
+
+async def test_events_follow_pr_lifecycle(service_client):
+    team_data = {"team_name": "feed", "members": [
+        {"user_id": "ev1", "username": "Eve", "is_active": True},
+        {"user_id": "ev2", "username": "Eli", "is_active": True},
+        {"user_id": "ev3", "username": "Ema", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    since = await _head(service_client)
+
+    await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-ev-1", "pull_request_name": "Feed",
+              "author_id": "ev1"})
+    events, since = await _collect(service_client, since, 3)
+    assert sorted((e["type"], e["pull_request_id"], e["user_id"])
+                  for e in events) == [
+        ("pr_created", "pr-ev-1", "ev1"),
+        ("reviewer_assigned", "pr-ev-1", "ev2"),
+        ("reviewer_assigned", "pr-ev-1", "ev3"),
+    ]
+    seqs = [e["seq"] for e in events]
+    assert seqs == sorted(seqs)
+
+    await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-ev-1"})
+    # A repeated merge changes nothing and logs nothing.
+    await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-ev-1"})
+    await service_client.post(
+        "/users/setIsActive", json={"user_id": "ev3", "is_active": False})
+    events, _ = await _collect(service_client, since, 2)
+    assert [(e["type"], e.get("pull_request_id"), e["user_id"])
+            for e in events] == [
+        ("pr_merged", "pr-ev-1", "ev1"),
+        ("user_deactivated", None, "ev3"),
+    ]
+
+
+async def test_events_reviewer_swap(service_client):
+    team_data = {"team_name": "feed_swap", "members": [
+        {"user_id": "ev5", "username": "Eda", "is_active": True},
+        {"user_id": "ev6", "username": "Eke", "is_active": True},
+        {"user_id": "ev7", "username": "Ela", "is_active": True},
+        {"user_id": "ev8", "username": "Eon", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    response = await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-ev-2", "pull_request_name": "Swap",
+              "author_id": "ev5"})
+    old_user_id = response.json()["pr"]["assigned_reviewers"][0]
+    since = await _head(service_client)
+
+    response = await service_client.post(
+        "/pullRequest/reassign",
+        json={"pull_request_id": "pr-ev-2", "old_user_id": old_user_id})
+    assert response.status == 200
+    new_user_id = response.json()["replaced_by"]
+    # The in-place update is logged as the same pair of events.
+    events, _ = await _collect(service_client, since, 2)
+    assert [(e["type"], e["pull_request_id"], e["user_id"])
+            for e in events] == [
+        ("reviewer_unassigned", "pr-ev-2", old_user_id),
+        ("reviewer_assigned", "pr-ev-2", new_user_id),
+    ]
+
+
+async def test_events_long_poll_wakes_up(service_client):
+    await service_client.post("/team/add", json={
+        "team_name": "feed_poll", "members": [
+            {"user_id": "ev4", "username": "Eva", "is_active": True}]})
+    since = await _head(service_client)
+
+    poll = asyncio.ensure_future(service_client.get(
+        "/events", params={"since": since, "timeout_ms": 10000}))
+    await asyncio.sleep(0.2)
+    assert not poll.done()
+    await service_client.post(
+        "/users/setIsActive", json={"user_id": "ev4", "is_active": False})
+
+    response = await poll
+    assert response.status == 200
+    events = response.json()["events"]
+    assert events[0]["type"] == "user_deactivated"
+    assert response.json()["next_since"] == events[-1]["seq"]
+
+
+async def test_events_timeout_returns_empty_page(service_client):
+    since = await _head(service_client)
+    response = await service_client.get(
+        "/events", params={"since": since, "timeout_ms": 0})
+    assert response.status == 200
+    assert response.json() == {"events": [], "next_since": since}
+
+
+@pytest.mark.parametrize("params", [
+    {"since": "abc"},
+    {"since": -1},
+    {"since": 0, "limit": 0},
+    {"since": 0, "timeout_ms": 600000},
+])
+async def test_events_bad_args(service_client, params):
+    response = await service_client.get("/events", params=params)
+    assert response.status == 400
@@ -1,3 +1,5 @@
+import asyncio
+
 import pytest
 
 
@@ -203,3 +205,260 @@ async def test_pr_reassign_no_candidate(service_client):
         assert response.status == 409
         data = response.json()
         assert data["error"]["code"] == "NO_CANDIDATE"
+
+
+async def test_pr_create_balances_review_load(service_client):
+    team_data = {
+        "team_name": "balanced",
+        "members": [
+            {"user_id": "lb1", "username": "Ann", "is_active": True},
+            {"user_id": "lb2", "username": "Ben", "is_active": True},
+            {"user_id": "lb3", "username": "Cat", "is_active": True},
+            {"user_id": "lb4", "username": "Dan", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+
+    # Three PRs with two reviewers each spread evenly over three teammates.
+    for i in range(3):
+        response = await service_client.post(
+            "/pullRequest/create",
+            json={"pull_request_id": f"pr-lb{i}",
+                  "pull_request_name": f"Balanced {i}", "author_id": "lb1"},
+        )
+        assert response.status == 201
+
+    for user_id in ("lb2", "lb3", "lb4"):
+        response = await service_client.get(
+            "/users/getReview", params={"user_id": user_id})
+        assert len(response.json()["pull_requests"]) == 2
+
+
+async def test_pr_create_and_merge_concurrently(service_client):
+    members = [{"user_id": f"gc{i}", "username": f"Gc {i}",
+                "is_active": True} for i in range(4)]
+    await service_client.post(
+        "/team/add", json={"team_name": "group_commit", "members": members})
+
+    prs = [{"pull_request_id": f"pr-gc-{i}", "pull_request_name": f"PR {i}",
+            "author_id": f"gc{i % 4}"} for i in range(16)]
+    # The same id twice in one burst: exactly one of the two is created.
+    responses = await asyncio.gather(
+        *(service_client.post("/pullRequest/create", json=pr)
+          for pr in prs + [prs[0]]))
+    statuses = [response.status for response in responses]
+    assert statuses.count(201) == 16
+    assert statuses.count(409) == 1
+    for pr, response in zip(prs, responses):
+        if response.status == 201:
+            assert response.json()["pr"]["pull_request_id"] == \
+                pr["pull_request_id"]
+
+    responses = await asyncio.gather(
+        *(service_client.post("/pullRequest/merge",
+                              json={"pull_request_id": pr["pull_request_id"]})
+          for pr in prs))
+    for pr, response in zip(prs, responses):
+        assert response.status == 200
+        data = response.json()["pr"]
+        assert data["pull_request_id"] == pr["pull_request_id"]
+        assert data["status"] == "MERGED"
+
+
+async def test_pr_create_idempotency_key(service_client):
+    team_data = {"team_name": "idempotent", "members": [
+        {"user_id": "ik1", "username": "Ike", "is_active": True},
+        {"user_id": "ik2", "username": "Ira", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    pr_data = {"pull_request_id": "pr-ik-1",
+               "pull_request_name": "Retry me", "author_id": "ik1"}
+    headers = {"Idempotency-Key": "create-pr-ik-1"}
+
+    first = await service_client.post(
+        "/pullRequest/create", json=pr_data, headers=headers)
+    assert first.status == 201
+    assert "Idempotent-Replayed" not in first.headers
+
+    # Answered from memory instead of PR_EXISTS.
+    retry = await service_client.post(
+        "/pullRequest/create", json=pr_data, headers=headers)
+    assert retry.status == 201
+    assert retry.headers["Idempotent-Replayed"] == "true"
+    assert retry.json() == first.json()
+
+    other = dict(pr_data, pull_request_name="Another body")
+    response = await service_client.post(
+        "/pullRequest/create", json=other, headers=headers)
+    assert response.status == 422
+    assert response.json()["error"]["code"] == "IDEMPOTENCY_KEY_REUSED"
+
+    # Keys are per endpoint.
+    response = await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-ik-1"},
+        headers=headers)
+    assert response.status == 200
+    assert "Idempotent-Replayed" not in response.headers
+
+
+async def test_pr_merge_idempotency_key_concurrent(service_client):
+    team_data = {"team_name": "idempotent_merge", "members": [
+        {"user_id": "ik3", "username": "Ivo", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-ik-2", "pull_request_name": "Merge me",
+              "author_id": "ik3"})
+
+    headers = {"Idempotency-Key": "merge-pr-ik-2"}
+    responses = await asyncio.gather(
+        *(service_client.post("/pullRequest/merge",
+                              json={"pull_request_id": "pr-ik-2"},
+                              headers=headers)
+          for _ in range(8)))
+    assert all(response.status == 200 for response in responses)
+    # One request did the merge, the others got its response.
+    replayed = [response for response in responses
+                if "Idempotent-Replayed" in response.headers]
+    assert len(replayed) == 7
+    assert all(response.json() == responses[0].json()
+               for response in responses)
+
+
+async def test_pr_create_batch(service_client):
+    team_data = {"team_name": "batch_prs", "members": [
+        {"user_id": "bp1", "username": "Bea", "is_active": True},
+        {"user_id": "bp2", "username": "Bob", "is_active": True},
+        {"user_id": "bp3", "username": "Ben", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-bp-0", "pull_request_name": "Existing",
+              "author_id": "bp1"})
+
+    batch = {"pull_requests": [
+        {"pull_request_id": "pr-bp-1", "pull_request_name": "One",
+         "author_id": "bp1"},
+        {"pull_request_id": "pr-bp-0", "pull_request_name": "Again",
+         "author_id": "bp2"},
+        {"pull_request_id": "pr-bp-2", "pull_request_name": "Two",
+         "author_id": "nobody"},
+        {"pull_request_id": "pr-bp-3", "pull_request_name": "Three",
+         "author_id": "bp2"},
+        {"pull_request_id": "pr-bp-1", "pull_request_name": "Repeated",
+         "author_id": "bp3"},
+    ]}
+    response = await service_client.post(
+        "/pullRequest/createBatch", json=batch)
+    assert response.status == 200
+    results = response.json()["results"]
+    assert len(results) == 5
+
+    assert results[0]["pr"]["pull_request_id"] == "pr-bp-1"
+    assert results[0]["pr"]["status"] == "OPEN"
+    assert sorted(results[0]["pr"]["assigned_reviewers"]) == ["bp2", "bp3"]
+    assert results[1]["error"]["code"] == "PR_EXISTS"
+    assert results[2]["error"]["code"] == "NOT_FOUND"
+    assert results[3]["pr"]["author_id"] == "bp2"
+    assert "bp2" not in results[3]["pr"]["assigned_reviewers"]
+    assert len(results[3]["pr"]["assigned_reviewers"]) == 2
+    assert results[4]["error"]["code"] == "PR_EXISTS"
+
+    response = await service_client.get(
+        "/users/getReview", params={"user_id": "bp3"})
+    ids = [pr["pull_request_id"] for pr in response.json()["pull_requests"]]
+    assert "pr-bp-1" in ids
+
+
+async def test_pr_merge_batch(service_client):
+    team_data = {"team_name": "batch_merge", "members": [
+        {"user_id": "bm1", "username": "Max", "is_active": True},
+        {"user_id": "bm2", "username": "Mia", "is_active": True}]}
+    await service_client.post("/team/add", json=team_data)
+    for pr_id in ("pr-bm-1", "pr-bm-2"):
+        await service_client.post(
+            "/pullRequest/create",
+            json={"pull_request_id": pr_id, "pull_request_name": pr_id,
+                  "author_id": "bm1"})
+    first = await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-bm-1"})
+
+    response = await service_client.post(
+        "/pullRequest/mergeBatch",
+        json={"pull_request_ids": ["pr-bm-2", "missing", "pr-bm-1"]})
+    assert response.status == 200
+    results = response.json()["results"]
+    assert results[0]["pr"]["pull_request_id"] == "pr-bm-2"
+    assert results[0]["pr"]["status"] == "MERGED"
+    assert results[0]["pr"]["assigned_reviewers"] == ["bm2"]
+    assert results[1]["error"]["code"] == "NOT_FOUND"
+    assert results[2]["pr"]["mergedAt"] == first.json()["pr"]["mergedAt"]
+
+
+async def test_pr_reassign_concurrent_same_pr(service_client):
+    members = [{"user_id": f"rc{i}", "username": f"Rc {i}",
+                "is_active": True} for i in range(10)]
+    await service_client.post(
+        "/team/add", json={"team_name": "reassign_race", "members": members})
+    response = await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-rc", "pull_request_name": "Race",
+              "author_id": "rc0"})
+    reviewers = response.json()["pr"]["assigned_reviewers"]
+    assert len(reviewers) == 2
+
+    for _ in range(3):
+        # Both reviewers many times over: per old reviewer exactly one
+        # request wins, the rest find it no longer assigned.
+        responses = await asyncio.gather(*(
+            service_client.post(
+                "/pullRequest/reassign",
+                json={"pull_request_id": "pr-rc", "old_user_id": old})
+            for old in reviewers for _ in range(8)))
+        statuses = [response.status for response in responses]
+        assert statuses.count(200) == 2
+        assert statuses.count(409) == 14
+        assert all(response.json()["error"]["code"] == "NOT_ASSIGNED"
+                   for response in responses if response.status == 409)
+
+        # The last successful answer saw the other one's write.
+        final = max((response.json()["pr"]["assigned_reviewers"]
+                     for response in responses if response.status == 200),
+                    key=lambda r: len(set(r) - set(reviewers)))
+        assert len(set(final)) == 2
+        assert not set(final) & set(reviewers)
+        assert "rc0" not in final
+        reviewers = final
+
+
+async def test_pr_reassign_races_with_merge(service_client):
+    members = [{"user_id": f"rm{i}", "username": f"Rm {i}",
+                "is_active": True} for i in range(6)]
+    await service_client.post(
+        "/team/add", json={"team_name": "reassign_merge", "members": members})
+    response = await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-rm", "pull_request_name": "Race",
+              "author_id": "rm0"})
+    old = response.json()["pr"]["assigned_reviewers"][0]
+
+    responses = await asyncio.gather(
+        *(service_client.post(
+            "/pullRequest/reassign",
+            json={"pull_request_id": "pr-rm", "old_user_id": old})
+          for _ in range(4)),
+        service_client.post(
+            "/pullRequest/merge", json={"pull_request_id": "pr-rm"}))
+    merge = responses[-1]
+    assert merge.status == 200
+    reassigns = responses[:-1]
+    succeeded = [r for r in reassigns if r.status == 200]
+    assert len(succeeded) <= 1
+    for r in reassigns:
+        if r.status == 409:
+            assert r.json()["error"]["code"] in ("NOT_ASSIGNED", "PR_MERGED")
+
+    # The merged PR shows exactly the reviewers the winner left behind.
+    merged_reviewers = merge.json()["pr"]["assigned_reviewers"]
+    assert len(set(merged_reviewers)) == 2
+    if succeeded and old not in merged_reviewers:
+        assert succeeded[0].json()["replaced_by"] in merged_reviewers
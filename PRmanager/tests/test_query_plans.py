@@ -0,0 +1,73 @@
+import json
+
+import pytest
+
+# Statements on the request path and the archiver's hourly scan, with
+# sample arguments. Full reloads (select_roster, select_review_loads,
+# select_stats_pull_requests, count_rows) read whole tables on purpose and
+# are not listed.
+HOT_QUERIES = {
+    "select_team_members": ["backend"],
+    "upsert_users": [["u1"], ["Alice"], ["backend"], [True]],
+    "set_user_active": [False, "u1"],
+    "deactivate_users": [["u1", "u2"]],
+    "select_user_team": ["u1"],
+    "select_active_teammates": ["backend", ["u1"]],
+    "select_active_teammates_of_authors": [["u1", "u2"]],
+    "insert_pull_request": ["pr-1", "Fix", "u1", ["u2", "u3"]],
+    "insert_pull_requests": [["pr-1"], ["Fix"], ["u1"], ["pr-1"], ["u2"]],
+    "merge_pull_request": ["pr-1"],
+    "merge_pull_requests": [["pr-1", "pr-2"]],
+    "select_stats_pull_requests_by_ids": [["pr-1", "pr-2"]],
+    "lock_pull_request_for_reassign": ["pr-1", "u2"],
+    "swap_reviewers": [[1], [2], ["u3"]],
+    "lock_open_reviews": [[1, 2]],
+    "remove_reviewers": [[1], [2]],
+    "select_reviews": ["u2", "OPEN", "2024-01-01T00:00:00+00:00", 1, 50],
+    "select_events": [0, 100, 1000],
+    "select_archivable_months": ["2024-01-01T00:00:00+00:00"],
+}
+
+# Partitions are named after their table: pull_requests_hot,
+# reviewers_2024_01.
+TABLES = {"teams", "users", "pull_request_keys", "pull_requests",
+          "reviewers", "events"}
+
+
+def _is_table(name):
+    return any(name == t or name.startswith(t + "_") for t in TABLES)
+
+
+def _seq_scans(plan):
+    found = []
+    if plan["Node Type"] == "Seq Scan" and _is_table(plan["Relation Name"]):
+        found.append(plan["Relation Name"])
+    for child in plan.get("Plans", []):
+        found.extend(_seq_scans(child))
+    return found
+
+
+def test_hot_queries_exist(queries):
+    assert set(HOT_QUERIES) <= set(queries)
+
+
+# Tables are nearly empty here, where a sequential scan is the cheapest plan.
+# With enable_seqscan off the planner still falls back to one when no index
+# fits, so a seq scan in the plan means a missing or unusable index.
+@pytest.mark.parametrize("name", sorted(HOT_QUERIES))
+def test_query_uses_indexes(pgsql, queries, name):
+    args = HOT_QUERIES[name]
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute("SET enable_seqscan = off")
+    cursor.execute(f"PREPARE plan_check AS {queries[name]}")
+    try:
+        placeholders = ", ".join(["%s"] * len(args))
+        cursor.execute(
+            f"EXPLAIN (FORMAT JSON) EXECUTE plan_check({placeholders})", args)
+        plan = cursor.fetchone()[0]
+        if isinstance(plan, str):
+            plan = json.loads(plan)
+    finally:
+        cursor.execute("DEALLOCATE plan_check")
+        cursor.execute("RESET enable_seqscan")
+    assert _seq_scans(plan[0]["Plan"]) == [], json.dumps(plan, indent=2)
@@ -37,3 +37,86 @@ async def test_stats(service_client):
     assert isinstance(data["teams_count"], int)
     assert isinstance(data["users_count"], int)
     assert isinstance(data["prs_count"], int)
+
+
+async def test_stats_counts_writes(service_client):
+    before = (await service_client.get("/stats")).json()
+
+    team_data = {
+        "team_name": "counted",
+        "members": [
+            {"user_id": "cnt1", "username": "A", "is_active": True},
+            {"user_id": "cnt2", "username": "B", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    pr_data = {"pull_request_id": "pr-counted",
+               "pull_request_name": "Counted", "author_id": "cnt1"}
+    await service_client.post("/pullRequest/create", json=pr_data)
+    # Duplicates must not be counted twice
+    await service_client.post("/pullRequest/create", json=pr_data)
+
+    after = (await service_client.get("/stats")).json()
+    assert after["teams_count"] - before["teams_count"] == 1
+    assert after["users_count"] - before["users_count"] == 2
+    assert after["prs_count"] - before["prs_count"] == 1
+
+
+async def test_stats_aggregates(service_client):
+    team_data = {
+        "team_name": "aggregated",
+        "members": [
+            {"user_id": "ag1", "username": "A", "is_active": True},
+            {"user_id": "ag2", "username": "B", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    for i in range(2):
+        pr_data = {"pull_request_id": f"pr-agg-{i}",
+                   "pull_request_name": f"Agg {i}", "author_id": "ag1"}
+        await service_client.post("/pullRequest/create", json=pr_data)
+    await service_client.post("/pullRequest/merge", json={"pull_request_id": "pr-agg-0"})
+
+    await service_client.invalidate_caches(cache_names=["stats-aggregates-cache"])
+
+    data = (await service_client.get("/stats")).json()
+    assert data["open_prs_count"] >= 1
+    assert data["merged_prs_count"] >= 1
+    assert "mean_time_to_merge_seconds" in data
+    assert {"team_name": "aggregated", "open_prs_count": 1} in data["teams_load"]
+
+    response = await service_client.get("/stats/reviewers", params={"limit": 1000})
+    assert response.status == 200
+    reviewers = {r["user_id"]: r for r in response.json()["reviewers"]}
+    assert reviewers["ag2"] == {"user_id": "ag2", "open_count": 1, "total_count": 2}
+
+
+async def test_stats_reviewers_bad_limit(service_client):
+    response = await service_client.get("/stats/reviewers", params={"limit": 0})
+    assert response.status == 400
+
+
+async def test_operation_metrics(service_client, monitor_client):
+    team_data = {
+        "team_name": "metrics",
+        "members": [
+            {"user_id": "mt1", "username": "Mia", "is_active": True},
+            {"user_id": "mt2", "username": "Max", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    response = await service_client.post(
+        "/pullRequest/create",
+        json={"pull_request_id": "pr-mt1",
+              "pull_request_name": "Metrics", "author_id": "mt1"},
+    )
+    assert response.status == 201
+
+    metric = await monitor_client.single_metric(
+        "prmanager.operations.requests", labels={"operation": "pr_create"})
+    assert metric.value >= 1
+
+    metrics = await monitor_client.metrics(
+        prefix="prmanager.operations.statements",
+        labels={"operation": "pr_create"})
+    assert metrics
@@ -76,3 +76,85 @@ async def test_team_add_moves_user(service_client):
     data = resp.json()
     ids = [m["user_id"] for m in data["members"]]
     assert "u_move" in ids
+
+
+async def test_team_add_batch(service_client):
+    await service_client.post("/team/add", json={
+        "team_name": "batch-existing",
+        "members": [{"user_id": "bt0", "username": "Zero", "is_active": True}],
+    })
+
+    batch = {
+        "teams": [
+            {"team_name": "batch-a", "members": [
+                {"user_id": "bt1", "username": "One", "is_active": True},
+                {"user_id": "bt2", "username": "Two", "is_active": False},
+            ]},
+            {"team_name": "batch-existing", "members": [
+                {"user_id": "bt3", "username": "Three", "is_active": True},
+            ]},
+            {"team_name": "batch-b", "members": [
+                {"user_id": "bt1", "username": "One", "is_active": True},
+            ]},
+        ],
+    }
+    response = await service_client.post("/team/addBatch", json=batch)
+    assert response.status == 200
+    results = response.json()["results"]
+    assert results[0]["team"]["team_name"] == "batch-a"
+    assert results[1]["error"]["code"] == "TEAM_EXISTS"
+    assert results[2]["team"]["team_name"] == "batch-b"
+
+    # The last entry of a repeated user wins
+    response = await service_client.get("/team/get", params={"team_name": "batch-a"})
+    assert [m["user_id"] for m in response.json()["members"]] == ["bt2"]
+    response = await service_client.get("/team/get", params={"team_name": "batch-b"})
+    assert [m["user_id"] for m in response.json()["members"]] == ["bt1"]
+
+
+async def test_team_get_sees_own_writes(service_client):
+    await service_client.post("/team/add", json={
+        "team_name": "cached",
+        "members": [
+            {"user_id": "c1", "username": "One", "is_active": True},
+            {"user_id": "c2", "username": "Two", "is_active": True},
+        ],
+    })
+
+    async def get_members():
+        response = await service_client.get(
+            "/team/get", params={"team_name": "cached"})
+        assert response.status == 200
+        return {m["user_id"]: m["is_active"] for m in response.json()["members"]}
+
+    assert await get_members() == {"c1": True, "c2": True}
+
+    await service_client.post(
+        "/users/setIsActive", json={"user_id": "c1", "is_active": False})
+    assert await get_members() == {"c1": False, "c2": True}
+
+    await service_client.post(
+        "/users/massDeactivate", json={"user_ids": ["c2"]})
+    assert await get_members() == {"c1": False, "c2": False}
+
+    # Moving a member to another team changes the old team as well
+    await service_client.post("/team/add", json={
+        "team_name": "cached-new",
+        "members": [{"user_id": "c2", "username": "Two", "is_active": True}],
+    })
+    assert await get_members() == {"c1": False}
+
+
+async def test_team_get_caches_not_found(service_client):
+    response = await service_client.get(
+        "/team/get", params={"team_name": "cached-later"})
+    assert response.status == 404
+
+    await service_client.post("/team/add", json={
+        "team_name": "cached-later",
+        "members": [{"user_id": "cl1", "username": "One", "is_active": True}],
+    })
+    response = await service_client.get(
+        "/team/get", params={"team_name": "cached-later"})
+    assert response.status == 200
+    assert response.json()["members"][0]["user_id"] == "cl1"
@@ -38,3 +38,147 @@ async def test_mass_deactivate_zero(service_client):
     assert response.status == 200
     data = response.json()
     assert data["deactivated_count"] == 0
+
+
+async def test_deactivated_user_not_assigned(service_client):
+    team_data = {
+        "team_name": "roster",
+        "members": [
+            {"user_id": "ro1", "username": "A", "is_active": True},
+            {"user_id": "ro2", "username": "B", "is_active": True},
+            {"user_id": "ro3", "username": "C", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    await service_client.post(
+        "/users/setIsActive", json={"user_id": "ro2", "is_active": False}
+    )
+
+    pr_data = {"pull_request_id": "pr-roster",
+               "pull_request_name": "Roster", "author_id": "ro1"}
+    response = await service_client.post("/pullRequest/create", json=pr_data)
+    assert response.status == 201
+    assert response.json()["pr"]["assigned_reviewers"] == ["ro3"]
+
+
+async def test_mass_deactivate_reassigns_open_prs(service_client):
+    team_data = {
+        "team_name": "mass",
+        "members": [
+            {"user_id": "ma1", "username": "A", "is_active": True},
+            {"user_id": "ma2", "username": "B", "is_active": True},
+            {"user_id": "ma3", "username": "C", "is_active": True},
+            {"user_id": "ma4", "username": "D", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    for i in range(3):
+        pr_data = {"pull_request_id": f"pr-mass-{i}",
+                   "pull_request_name": f"Mass {i}", "author_id": "ma1"}
+        await service_client.post("/pullRequest/create", json=pr_data)
+
+    response = await service_client.post(
+        "/users/massDeactivate", json={"user_ids": ["ma2", "ma3"]}
+    )
+    assert response.status == 200
+    assert response.json()["deactivated_count"] == 2
+
+    for user_id in ("ma2", "ma3"):
+        response = await service_client.get(
+            "/users/getReview", params={"user_id": user_id})
+        assert response.json()["pull_requests"] == []
+
+    response = await service_client.get(
+        "/users/getReview", params={"user_id": "ma4"})
+    assert len(response.json()["pull_requests"]) == 3
+
+
+async def test_user_get_review_pages(service_client):
+    team_data = {
+        "team_name": "paged",
+        "members": [
+            {"user_id": "pg1", "username": "A", "is_active": True},
+            {"user_id": "pg2", "username": "B", "is_active": True},
+        ],
+    }
+    await service_client.post("/team/add", json=team_data)
+    for i in range(5):
+        pr_data = {"pull_request_id": f"pr-page-{i}",
+                   "pull_request_name": f"Page {i}", "author_id": "pg1"}
+        await service_client.post("/pullRequest/create", json=pr_data)
+    await service_client.post("/pullRequest/merge", json={"pull_request_id": "pr-page-0"})
+
+    seen = []
+    params = {"user_id": "pg2", "limit": 2}
+    while True:
+        response = await service_client.get("/users/getReview", params=params)
+        assert response.status == 200
+        data = response.json()
+        assert len(data["pull_requests"]) <= 2
+        seen += [pr["pull_request_id"] for pr in data["pull_requests"]]
+        if "next_cursor" not in data:
+            break
+        params["cursor"] = data["next_cursor"]
+    assert sorted(seen) == [f"pr-page-{i}" for i in range(5)]
+
+    response = await service_client.get(
+        "/users/getReview", params={"user_id": "pg2", "status": "OPEN"})
+    assert len(response.json()["pull_requests"]) == 4
+
+    # Unpaged responses are streamed but keep the same shape
+    response = await service_client.get("/users/getReview", params={"user_id": "pg2"})
+    assert response.status == 200
+    assert len(response.json()["pull_requests"]) == 5
+
+
+async def test_user_get_review_bad_args(service_client):
+    for params in ({"user_id": "x", "status": "CLOSED"},
+                   {"user_id": "x", "limit": 0},
+                   {"user_id": "x", "cursor": "!!!"},
+                   # Cursors used to carry the text PR id.
+                   {"user_id": "x", "cursor": "MTcwMDAwMDAwMDAwMDAwMDpwci0x"}):
+        response = await service_client.get("/users/getReview", params=params)
+        assert response.status == 400
+
+
+async def test_read_your_writes_token(service_client):
+    rw = {"X-Consistency": "read-your-writes"}
+    response = await service_client.post("/team/add", headers=rw, json={
+        "team_name": "ryw",
+        "members": [
+            {"user_id": "ryw1", "username": "A", "is_active": True},
+            {"user_id": "ryw2", "username": "B", "is_active": True},
+        ],
+    })
+    assert response.status == 201
+    assert "X-Consistency-Token" in response.headers
+
+    response = await service_client.post("/pullRequest/create", headers=rw, json={
+        "pull_request_id": "pr-ryw", "pull_request_name": "RYW",
+        "author_id": "ryw1"})
+    assert response.status == 201
+    token = {"X-Consistency-Token": response.headers["X-Consistency-Token"]}
+
+    for params in ({"user_id": "ryw2"}, {"user_id": "ryw2", "limit": 10}):
+        response = await service_client.get(
+            "/users/getReview", params=params, headers=token)
+        assert response.status == 200
+        assert [pr["pull_request_id"] for pr in response.json()["pull_requests"]] == ["pr-ryw"]
+
+    response = await service_client.get(
+        "/team/get", params={"team_name": "ryw"}, headers=token)
+    assert response.status == 200
+    assert len(response.json()["members"]) == 2
+
+    # Writes without the mode header do not pay for a token
+    response = await service_client.post(
+        "/pullRequest/merge", json={"pull_request_id": "pr-ryw"})
+    assert response.status == 200
+    assert "X-Consistency-Token" not in response.headers
+
+
+async def test_bad_consistency_token(service_client):
+    response = await service_client.get(
+        "/team/get", params={"team_name": "any"},
+        headers={"X-Consistency-Token": "not-an-lsn"})
+    assert response.status == 400
@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+#include "models/event_log.hpp"
+
+using prmanager::models::Event;
+using prmanager::models::EventLog;
+using prmanager::models::Snapshot;
+
+namespace {
+
+// Transaction 100 is still running.
+constexpr Snapshot kBusy{100, 110};
+
+std::vector<Event> MakeEvents(const std::vector<std::int64_t>& seqs) {
+  std::vector<Event> events;
+  for (const auto seq : seqs) {
+    events.push_back(Event{seq, "pr_created", "pr" + std::to_string(seq),
+                           std::nullopt, "2025-11-23T00:00:00Z"});
+  }
+  return events;
+}
+
+std::vector<std::int64_t> Seqs(const std::vector<Event>& events) {
+  std::vector<std::int64_t> seqs;
+  for (const auto& event : events) {
+    seqs.push_back(event.seq);
+  }
+  return seqs;
+}
+
+}  // namespace
+
+UTEST(EventLog, ReadsAfterSince) {
+  EventLog log{10, 5};
+  EXPECT_EQ(log.Append(MakeEvents({4, 5, 6, 7, 8}), kBusy), 3u);
+  EXPECT_EQ(log.GetHead(), 8);
+
+  EXPECT_TRUE(log.Covers(5));
+  EXPECT_FALSE(log.Covers(4));
+  EXPECT_EQ(Seqs(log.Read(5, 10)), (std::vector<std::int64_t>{6, 7, 8}));
+  EXPECT_EQ(Seqs(log.Read(6, 1)), (std::vector<std::int64_t>{7}));
+  EXPECT_TRUE(log.Read(8, 10).empty());
+}
+
+UTEST(EventLog, WaitsForGapBeforeSkipping) {
+  EventLog log{10, 0};
+  EXPECT_EQ(log.Append(MakeEvents({1, 3, 4}), kBusy), 1u);
+  EXPECT_EQ(log.GetHead(), 1);
+
+  // The transaction holding seq 2 commits.
+  EXPECT_EQ(log.Append(MakeEvents({2, 3, 4}), Snapshot{105, 112}), 3u);
+  EXPECT_EQ(log.GetHead(), 4);
+
+  // Seq 5 never shows up. Its transaction is below the xmax of the first
+  // snapshot without it, so the gap stays until xmin reaches that.
+  EXPECT_EQ(log.Append(MakeEvents({6}), Snapshot{105, 120}), 0u);
+  EXPECT_EQ(log.Append(MakeEvents({6}), Snapshot{119, 130}), 0u);
+  EXPECT_EQ(log.Append(MakeEvents({6}), Snapshot{120, 130}), 1u);
+  EXPECT_EQ(Seqs(log.Read(0, 10)), (std::vector<std::int64_t>{1, 2, 3, 4, 6}));
+
+  // Readers may have moved past it.
+  EXPECT_EQ(log.Append(MakeEvents({5}), kBusy), 0u);
+}
+
+UTEST(EventLog, SkipsGapAtOnceWhenNothingRuns) {
+  EventLog log{10, 0};
+  EXPECT_EQ(log.Append(MakeEvents({2, 3}), Snapshot{110, 110}), 2u);
+  EXPECT_EQ(log.GetHead(), 3);
+}
+
+UTEST(EventLog, EvictsOldest) {
+  EventLog log{3, 0};
+  log.Append(MakeEvents({1, 2, 3, 4, 5}), kBusy);
+
+  EXPECT_FALSE(log.Covers(1));
+  EXPECT_TRUE(log.Covers(2));
+  EXPECT_EQ(Seqs(log.Read(2, 10)), (std::vector<std::int64_t>{3, 4, 5}));
+}
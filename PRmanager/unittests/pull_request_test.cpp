@@ -24,3 +24,37 @@ UTEST(PullRequestSerialize, OptionalFields) {
   EXPECT_TRUE(json["createdAt"].IsString());
   EXPECT_TRUE(json["mergedAt"].IsMissing());
 }
+
+UTEST(PullRequestWriteToStream, MatchesSerialize) {
+  PullRequest pr{"pr1",
+                 "Fix \"quoted\" bug",
+                 "author1",
+                 "MERGED",
+                 std::vector<std::string>{"r1", "r2"},
+                 std::optional<std::string>{},
+                 std::optional<std::string>{"2025-11-23T00:00:00Z"}};
+  userver::formats::json::StringBuilder sw;
+  prmanager::models::WriteToStream(pr, sw);
+
+  EXPECT_EQ(userver::formats::json::FromString(sw.GetString()),
+            prmanager::models::Serialize(
+                pr, userver::formats::serialize::To<
+                        userver::formats::json::Value>{}));
+}
+
+UTEST(PullRequestParse, CreateBatch) {
+  auto json = userver::formats::json::FromString(R"({"pull_requests": [
+      {"pull_request_id": "pr1", "pull_request_name": "A", "author_id": "u1"},
+      {"pull_request_id": "pr2", "pull_request_name": "B", "author_id": "u2"}
+  ]})");
+  auto parsed = json.As<prmanager::models::PullRequestCreateBatchRequest>();
+  ASSERT_EQ(parsed.pull_requests.size(), 2u);
+  EXPECT_EQ(parsed.pull_requests[1].pull_request_id, "pr2");
+  EXPECT_EQ(parsed.pull_requests[1].author_id, "u2");
+
+  auto merge = userver::formats::json::FromString(
+                   R"({"pull_request_ids": ["pr1", "pr2"]})")
+                   .As<prmanager::models::PullRequestMergeBatchRequest>();
+  EXPECT_EQ(merge.pull_request_ids,
+            (std::vector<std::string>{"pr1", "pr2"}));
+}
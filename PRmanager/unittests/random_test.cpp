@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+#include "utils/random.hpp"
+
+using prmanager::utils::Xoshiro256;
+
+namespace {
+
+std::vector<std::uint64_t> Draw(std::size_t count) {
+  return prmanager::utils::WithRng([count](auto& rng) {
+    std::vector<std::uint64_t> values(count);
+    std::generate(values.begin(), values.end(), std::ref(rng));
+    return values;
+  });
+}
+
+}  // namespace
+
+UTEST(Random, SameSeedSameSequence) {
+  Xoshiro256 first{42};
+  Xoshiro256 second{42};
+  Xoshiro256 other{43};
+  for (int i = 0; i < 100; ++i) {
+    const auto value = first();
+    EXPECT_EQ(value, second());
+    EXPECT_NE(value, other());
+  }
+}
+
+UTEST(Random, DeterministicSeedRestartsThreadGenerator) {
+  prmanager::utils::SetDeterministicSeed(7);
+  const auto first = Draw(16);
+  prmanager::utils::SetDeterministicSeed(7);
+  EXPECT_EQ(Draw(16), first);
+
+  prmanager::utils::SetDeterministicSeed(std::nullopt);
+  EXPECT_NE(Draw(16), first);
+}
+
+UTEST(Random, WorksWithStandardDistributions) {
+  Xoshiro256 rng{1};
+  std::uniform_int_distribution<int> distribution{0, 9};
+  std::vector<int> counts(10);
+  for (int i = 0; i < 10000; ++i) {
+    ++counts[distribution(rng)];
+  }
+  for (const auto count : counts) {
+    EXPECT_GT(count, 800);
+  }
+}
@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+#include <userver/formats/json.hpp>
+
+#include "models/response.hpp"
+
+using prmanager::models::ErrorResponse;
+using prmanager::models::EventsResponse;
+using prmanager::models::PullRequestBatchResponse;
+using prmanager::models::PullRequestResponse;
+using prmanager::models::TeamAddBatchResponse;
+using prmanager::models::ToJsonString;
+
+UTEST(ResponseToJsonString, Error) {
+  auto json = userver::formats::json::FromString(
+      ToJsonString(ErrorResponse{"NOT_FOUND", "PR not found"}));
+  EXPECT_EQ(json["error"]["code"].As<std::string>(), "NOT_FOUND");
+  EXPECT_EQ(json["error"]["message"].As<std::string>(), "PR not found");
+}
+
+UTEST(ResponseToJsonString, PullRequestReplacedBy) {
+  PullRequestResponse response;
+  response.pr.pull_request_id = "pr1";
+  response.pr.assigned_reviewers = {"u2"};
+
+  auto json = userver::formats::json::FromString(ToJsonString(response));
+  EXPECT_EQ(json["pr"]["pull_request_id"].As<std::string>(), "pr1");
+  EXPECT_TRUE(json["replaced_by"].IsMissing());
+
+  response.replaced_by = "u2";
+  json = userver::formats::json::FromString(ToJsonString(response));
+  EXPECT_EQ(json["replaced_by"].As<std::string>(), "u2");
+}
+
+UTEST(ResponseToJsonString, TeamAddBatch) {
+  TeamAddBatchResponse response;
+  response.results.resize(2);
+  response.results[0].team = prmanager::models::Team{"teamA", {}};
+  response.results[1].error = ErrorResponse{"TEAM_EXISTS", "exists"};
+
+  auto json = userver::formats::json::FromString(ToJsonString(response));
+  ASSERT_EQ(json["results"].GetSize(), 2u);
+  EXPECT_EQ(json["results"][0]["team"]["team_name"].As<std::string>(),
+            "teamA");
+  EXPECT_EQ(json["results"][1]["error"]["code"].As<std::string>(),
+            "TEAM_EXISTS");
+}
+
+UTEST(ResponseToJsonString, PullRequestBatch) {
+  PullRequestBatchResponse response;
+  response.results.resize(2);
+  response.results[0].error = ErrorResponse{"NOT_FOUND", "PR not found"};
+  response.results[1].pr = prmanager::models::PullRequest{};
+  response.results[1].pr->pull_request_id = "pr1";
+
+  auto json = userver::formats::json::FromString(ToJsonString(response));
+  ASSERT_EQ(json["results"].GetSize(), 2u);
+  EXPECT_EQ(json["results"][0]["error"]["code"].As<std::string>(),
+            "NOT_FOUND");
+  EXPECT_EQ(json["results"][1]["pr"]["pull_request_id"].As<std::string>(),
+            "pr1");
+}
+
+UTEST(ResponseToJsonString, Events) {
+  EventsResponse response;
+  response.events.push_back(prmanager::models::Event{
+      7, "reviewer_assigned", "pr1", "u2", "2025-11-23T00:00:00Z"});
+  response.events.push_back(prmanager::models::Event{
+      8, "user_deactivated", std::nullopt, "u3", "2025-11-23T00:00:01Z"});
+  response.next_since = 8;
+
+  auto json = userver::formats::json::FromString(ToJsonString(response));
+  ASSERT_EQ(json["events"].GetSize(), 2u);
+  EXPECT_EQ(json["events"][0]["seq"].As<std::int64_t>(), 7);
+  EXPECT_EQ(json["events"][0]["pull_request_id"].As<std::string>(), "pr1");
+  EXPECT_TRUE(json["events"][1]["pull_request_id"].IsMissing());
+  EXPECT_EQ(json["next_since"].As<std::int64_t>(), 8);
+}
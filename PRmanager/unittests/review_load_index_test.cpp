@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+#include "models/review_load_index.hpp"
+#include "utils/random.hpp"
+
+using prmanager::models::ReviewLoadIndex;
+
+namespace {
+
+const auto kNoneExcluded = [](const std::string&) { return false; };
+
+}  // namespace
+
+UTEST(ReviewLoadIndex, PicksLeastLoadedActiveMembers) {
+  ReviewLoadIndex index;
+  index.SetMember("u1", "teamA", true);
+  index.SetMember("u2", "teamA", true);
+  index.SetMember("u3", "teamA", true);
+  index.SetMember("u4", "teamA", false);
+  index.SetMember("u5", "teamB", true);
+  index.SetLoad("u1", 3);
+  index.SetLoad("u2", 1);
+
+  EXPECT_EQ(index.PickLeastLoaded("teamA", 2, kNoneExcluded),
+            (std::vector<std::string>{"u3", "u2"}));
+  EXPECT_EQ(index.PickLeastLoaded(
+                "teamA", 2, [](const std::string& id) { return id == "u3"; }),
+            (std::vector<std::string>{"u2", "u1"}));
+  EXPECT_EQ(index.GetActiveCount("teamA"), 3u);
+  EXPECT_TRUE(index.PickLeastLoaded("missing", 2, kNoneExcluded).empty());
+}
+
+UTEST(ReviewLoadIndex, LoadFollowsAssignments) {
+  ReviewLoadIndex index;
+  index.SetMember("u1", "teamA", true);
+  index.SetMember("u2", "teamA", true);
+
+  index.AddLoad("u1", 1);
+  EXPECT_EQ(index.PickLeastLoaded("teamA", 1, kNoneExcluded),
+            std::vector<std::string>{"u2"});
+
+  index.AddLoad("u2", 2);
+  index.AddLoad("u1", -5);
+  EXPECT_EQ(index.GetLoad("u1"), 0);
+  EXPECT_EQ(index.PickLeastLoaded("teamA", 1, kNoneExcluded),
+            std::vector<std::string>{"u1"});
+}
+
+UTEST(ReviewLoadIndex, MembershipChangesKeepLoad) {
+  ReviewLoadIndex index;
+  index.AddLoad("u1", 2);
+  index.SetMember("u1", "teamA", true);
+  EXPECT_EQ(index.GetLoad("u1"), 2);
+
+  EXPECT_TRUE(index.SetMember("u1", "teamB", true));
+  EXPECT_FALSE(index.SetMember("u1", "teamB", true));
+  EXPECT_EQ(index.GetActiveCount("teamA"), 0u);
+  EXPECT_EQ(index.GetActiveCount("teamB"), 1u);
+
+  index.SetMember("u1", "teamB", false);
+  EXPECT_TRUE(index.PickLeastLoaded("teamB", 1, kNoneExcluded).empty());
+  EXPECT_EQ(index.GetLoad("u1"), 2);
+}
+
+UTEST(ReviewLoadIndex, TiesGoToDifferentMembers) {
+  std::set<std::string> picked;
+  for (std::uint64_t seed = 0; seed < 32; ++seed) {
+    prmanager::utils::SetDeterministicSeed(seed);
+    ReviewLoadIndex index;
+    for (const auto* user_id : {"u1", "u2", "u3", "u4"}) {
+      index.SetMember(user_id, "teamA", true);
+    }
+    picked.insert(index.PickLeastLoaded("teamA", 1, kNoneExcluded).front());
+  }
+  prmanager::utils::SetDeterministicSeed(std::nullopt);
+  EXPECT_GT(picked.size(), 1u);
+}
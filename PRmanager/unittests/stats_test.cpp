@@ -1,7 +1,11 @@
+#include <chrono>
+#include <optional>
+
 #include <userver/utest/utest.hpp>
 #include <userver/formats/json.hpp>
 
 #include "models/stats.hpp"
+#include "models/stats_aggregates.hpp"
 
 using prmanager::models::StatsResponse;
 
@@ -13,3 +17,57 @@ UTEST(StatsSerialize, Basic) {
   EXPECT_EQ(json["users_count"].As<int>(), 20);
   EXPECT_EQ(json["prs_count"].As<int>(), 30);
 }
+
+UTEST(StatsAggregates, OpenThenMerged) {
+  using prmanager::models::PullRequestState;
+  using std::chrono::seconds;
+  const auto created = std::chrono::system_clock::now();
+
+  prmanager::models::StatsAggregates aggregates;
+  aggregates.Apply("pr1", PullRequestState{"OPEN", "teamA", {"r1", "r2"},
+                                           created, std::nullopt});
+  aggregates.Apply("pr2", PullRequestState{"OPEN", "teamB", {"r1"}, created,
+                                           std::nullopt});
+  EXPECT_EQ(aggregates.GetOpenCount(), 2);
+  EXPECT_FALSE(aggregates.GetMeanTimeToMergeSeconds());
+
+  const auto merged = created + seconds{60};
+  aggregates.Apply("pr1", PullRequestState{"MERGED", "teamA", {"r1", "r2"},
+                                           created, merged});
+  // Re-reading a merged PR must not count it twice, even with other
+  // reviewers
+  aggregates.Apply("pr1", PullRequestState{"MERGED", "teamA", {"r1", "r3"},
+                                           created, merged});
+
+  EXPECT_EQ(aggregates.GetOpenCount(), 1);
+  EXPECT_EQ(aggregates.GetMergedCount(), 1);
+  ASSERT_TRUE(aggregates.GetMeanTimeToMergeSeconds());
+  EXPECT_EQ(*aggregates.GetMeanTimeToMergeSeconds(), 60.0);
+
+  const auto teams = aggregates.GetTeamsLoad();
+  ASSERT_EQ(teams.size(), 1u);
+  EXPECT_EQ(teams[0].team_name, "teamB");
+
+  const auto reviewers = aggregates.GetReviewers("", 10);
+  ASSERT_EQ(reviewers.size(), 2u);
+  EXPECT_EQ(reviewers[0].user_id, "r1");
+  EXPECT_EQ(reviewers[0].open_count, 1);
+  EXPECT_EQ(reviewers[0].total_count, 2);
+  EXPECT_EQ(aggregates.GetReviewers("r1", 10).size(), 1u);
+}
+
+UTEST(StatsAggregates, ReplacesOpenState) {
+  using prmanager::models::PullRequestState;
+  const auto created = std::chrono::system_clock::now();
+
+  prmanager::models::StatsAggregates aggregates;
+  aggregates.Apply("pr1", PullRequestState{"OPEN", "teamA", {"r1"}, created,
+                                           std::nullopt});
+  aggregates.Apply("pr1", PullRequestState{"OPEN", "teamA", {"r2"}, created,
+                                           std::nullopt});
+
+  EXPECT_EQ(aggregates.GetOpenCount(), 1);
+  const auto reviewers = aggregates.GetReviewers("", 10);
+  ASSERT_EQ(reviewers.size(), 1u);
+  EXPECT_EQ(reviewers[0].user_id, "r2");
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+#include "models/team_roster.hpp"
+
+using prmanager::models::RosterMember;
+using prmanager::models::TeamRoster;
+
+namespace {
+
+const auto kNow = std::chrono::system_clock::now();
+
+}  // namespace
+
+UTEST(TeamRoster, ActiveMembersExcludeInactiveAndExcluded) {
+  TeamRoster roster;
+  roster.Upsert({"u1", "teamA", true, kNow});
+  roster.Upsert({"u2", "teamA", true, kNow});
+  roster.Upsert({"u3", "teamA", false, kNow});
+  roster.Upsert({"u4", "teamB", true, kNow});
+
+  EXPECT_EQ(roster.size(), 4u);
+  EXPECT_EQ(roster.GetActiveMembers("teamA", {"u1"}),
+            std::vector<std::string>{"u2"});
+  EXPECT_TRUE(roster.GetActiveMembers("missing", {}).empty());
+}
+
+UTEST(TeamRoster, UpsertMovesAndDeactivates) {
+  TeamRoster roster;
+  roster.Upsert({"u1", "teamA", true, kNow});
+  roster.Upsert({"u1", "teamB", true, kNow + std::chrono::seconds{1}});
+
+  EXPECT_TRUE(roster.GetActiveMembers("teamA", {}).empty());
+  EXPECT_EQ(roster.GetActiveMembers("teamB", {}).size(), 1u);
+  EXPECT_EQ(roster.FindUser("u1")->team_name, "teamB");
+
+  roster.Upsert({"u1", "teamB", false, kNow + std::chrono::seconds{2}});
+  EXPECT_TRUE(roster.GetActiveMembers("teamB", {}).empty());
+  EXPECT_EQ(roster.size(), 1u);
+}
+
+UTEST(TeamRoster, UpsertIgnoresOlderRows) {
+  TeamRoster roster;
+  roster.Upsert({"u1", "teamA", false, kNow});
+  EXPECT_FALSE(
+      roster.Upsert({"u1", "teamA", true, kNow - std::chrono::seconds{1}}));
+  EXPECT_TRUE(roster.GetActiveMembers("teamA", {}).empty());
+}
+
+UTEST(TeamRoster, CopyKeepsOriginalAndTracksOwnChanges) {
+  TeamRoster roster;
+  roster.Upsert({"u1", "teamA", true, kNow});
+  roster.Upsert({"u2", "teamB", true, kNow});
+  EXPECT_EQ(roster.GetChanges().size(), 2u);
+
+  TeamRoster next{roster};
+  EXPECT_TRUE(next.GetChanges().empty());
+  next.Upsert({"u1", "teamA", false, kNow + std::chrono::seconds{1}});
+  next.Upsert({"u3", "teamA", true, kNow});
+
+  EXPECT_EQ(roster.GetActiveMembers("teamA", {}),
+            std::vector<std::string>{"u1"});
+  EXPECT_TRUE(roster.FindUser("u1")->is_active);
+  EXPECT_EQ(roster.FindUser("u3"), nullptr);
+  EXPECT_EQ(roster.size(), 2u);
+
+  EXPECT_EQ(next.GetActiveMembers("teamA", {}),
+            std::vector<std::string>{"u3"});
+  EXPECT_EQ(next.GetActiveMembers("teamB", {}),
+            std::vector<std::string>{"u2"});
+  EXPECT_EQ(next.size(), 3u);
+  ASSERT_EQ(next.GetChanges().size(), 2u);
+  EXPECT_EQ(next.GetChanges()[0]->user_id, "u1");
+  EXPECT_FALSE(next.GetChanges()[0]->is_active);
+  EXPECT_EQ(next.GetChanges()[1]->user_id, "u3");
+}
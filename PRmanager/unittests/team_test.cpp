@@ -7,6 +7,7 @@
 #include "models/team.hpp"
 
 using prmanager::models::Team;
+using prmanager::models::TeamAddBatchRequest;
 using prmanager::models::TeamMember;
 
 UTEST(TeamSerializeParse, Basic) {
@@ -23,3 +24,29 @@ UTEST(TeamSerializeParse, Basic) {
   EXPECT_EQ(parsed.members.size(), 2u);
   EXPECT_EQ(parsed.members[1].username, "bob");
 }
+
+UTEST(TeamWriteToStream, MatchesSerialize) {
+  Team team{"teamA", {{"id1", "alice", true}, {"id2", "bob", false}}};
+  userver::formats::json::StringBuilder sw;
+  prmanager::models::WriteToStream(team, sw);
+
+  EXPECT_EQ(userver::formats::json::FromString(sw.GetString()),
+            prmanager::models::Serialize(
+                team, userver::formats::serialize::To<
+                          userver::formats::json::Value>{}));
+}
+
+UTEST(TeamAddBatchParse, Basic) {
+  auto json = userver::formats::json::FromString(R"({
+    "teams": [
+      {"team_name": "teamA", "members": []},
+      {"team_name": "teamB",
+       "members": [{"user_id": "id1", "username": "alice", "is_active": true}]}
+    ]
+  })");
+  auto parsed = prmanager::models::Parse(
+      json, userver::formats::parse::To<TeamAddBatchRequest>{});
+  ASSERT_EQ(parsed.teams.size(), 2u);
+  EXPECT_EQ(parsed.teams[1].team_name, "teamB");
+  EXPECT_EQ(parsed.teams[1].members[0].user_id, "id1");
+}